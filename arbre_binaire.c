@@ -35,26 +35,517 @@
  *
  */
 
+#define _GNU_SOURCE
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#ifdef IO_URING_OP_SUPPORTED
+#define ARBRE_BINAIRE_IO_URING
+#endif
+#endif
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ARBRE_BINAIRE_AVX2
+#endif
 
 
 #include "arbre_binaire.h"
 
+/**
+ * \brief Valeur de hachage utilise pour un enfant absent.
+ */
+#define HACHAGE_ABSENT 0x9E3779B97F4A7C15ULL
+
+/**
+ * \brief Nombre maximal d'oprations d'entre/sortie en cours dans un lot.
+ */
+#define LOT_OPERATIONS 256
+
+/**
+ * \brief Taille initiale du tampon de lecture d'un fichier dans un lot.
+ */
+#define LOT_TAMPON 4096
+
+/**
+ * \brief Taille d'un noeud dans un fichier ou un tampon: la valeur et la
+ *        prsence de chacun des deux enfants.
+ */
+#define TAILLE_ENREGISTREMENT (3 * sizeof(valeur_arbre_binaire))
+
+/**
+ * \brief Signature place au dbut d'un fichier ou d'un tampon srialis.
+ */
+#define ENTETE_SIGNATURE "ABIN"
+
+/**
+ * \brief Version du format des enregistrements qui suivent l'en-tte. Les
+ *        fichiers de la version 1 n'ont pas d'en-tte et leurs
+ *        enregistrements sont forms de trois 'int'.
+ */
+#define ENTETE_VERSION 2
+
+/**
+ * \brief Taille de l'en-tte: la signature, la version, la taille en octets
+ *        d'une 'valeur_arbre_binaire' et deux octets nuls.
+ */
+#define TAILLE_ENTETE 8
+
+/**
+ * \brief Taille de l'en-tte crit par la srialisation. Seule la variante
+ *        ARBRE_BINAIRE_64 crit un en-tte; l'autre continue d'crire la
+ *        version 1 du format, lisible par les versions prcdentes.
+ */
+#ifdef ARBRE_BINAIRE_64
+#define TAILLE_ENTETE_ECRIT TAILLE_ENTETE
+#else
+#define TAILLE_ENTETE_ECRIT 0
+#endif
+
+/**
+ * \brief Taille d'un enregistrement de la version 1 du format.
+ */
+#define TAILLE_ENREGISTREMENT_VERSION_1 (3 * sizeof(int))
+
+/**
+ * \brief tapes du traitement d'un fichier dans un lot.
+ */
+#define ETAPE_OUVRIR 0
+#define ETAPE_TRANSFERER 1
+#define ETAPE_FERMER 2
+#define ETAPE_TERMINEE 3
+
+/**
+ * \brief Nombre de valeurs regroupes avant d'appliquer un traitement en
+ *        bloc.
+ */
+#define BLOC_VALEURS 1024
+
+/**
+ * \brief Nombre de noeuds conscutifs dont les profondeurs minimales sont
+ *        retrouves  l'aide d'un masque de 64 bits.
+ */
+#define BLOC_ANCETRES 64
+
+/**
+ * \brief Les bornes et la version non signe de 'valeur_arbre_binaire'.
+ */
+#ifdef ARBRE_BINAIRE_64
+#define VALEUR_MINIMALE INT64_MIN
+#define VALEUR_MAXIMALE INT64_MAX
+typedef uint64_t valeur_non_signee_arbre_binaire;
+#else
+#define VALEUR_MINIMALE INT_MIN
+#define VALEUR_MAXIMALE INT_MAX
+typedef unsigned int valeur_non_signee_arbre_binaire;
+#endif
+
 /**
  * \brief Un arbre binaire qui contient une valeur et des enfants.
+ *
+ * Un noeud 'partage' et tous ses descendants ne sont plus modifis sur
+ * place. Le 'parent' d'un noeud qui a plus d'une rfrence est NULL.
  */
 struct arbre_binaire_struct {
     struct arbre_binaire_struct* premier_enfant;
 	struct arbre_binaire_struct* second_enfant;
-	int valeur;
+	struct arbre_binaire_struct* parent;
+	valeur_arbre_binaire valeur;
     bool a_erreur;
+	bool hachage_valide;
+	atomic_uint references;
+	bool partage;
+	uint64_t hachage;
     char* erreur;
+	struct bloc_arbre_binaire_struct* bloc;
+	struct differe_arbre_binaire_struct* differe;
+	bool paresseux;
+};
+
+/**
+ * \brief Des noeuds allous ensemble lors d'un chargement.
+ *
+ * Le bloc est dsallou lorsque tous ses noeuds ont t dsallous: un seul
+ * noeud dtach de l'arbre et conserv garde donc tout le bloc en mmoire. Le
+ * 'differe' est le morceau charg paresseusement que forme le bloc ou NULL.
+ */
+typedef struct bloc_arbre_binaire_struct {
+	atomic_size_t vivants;
+	struct differe_arbre_binaire_struct* differe;
+	arbre_binaire noeuds[];
+} bloc_arbre_binaire;
+
+/**
+ * \brief Un fichier charg paresseusement et les morceaux de l'arbre qui en
+ *        ont t matrialiss, du plus ancien au plus rcent.
+ *
+ * Le 'contenu' commence au premier enregistrement, aprs les 'entete'
+ * octets de l'en-tte du fichier. Pour chaque enregistrement, 'fins'
+ * contient le numro de l'enregistrement qui suit son sous-arbre. La source
+ * est dsalloue lorsque plus aucun descripteur ne la rfrence.
+ */
+typedef struct source_arbre_binaire_struct {
+	pthread_mutex_t verrou;
+	char* contenu;
+	size_t taille;
+	size_t entete;
+	size_t* fins;
+	int profondeur;
+	int* attentes;
+	size_t budget;
+	size_t residents;
+	size_t references;
+	unsigned long generation;
+	struct differe_arbre_binaire_struct* plus_ancien;
+	struct differe_arbre_binaire_struct* plus_recent;
+} source_arbre_binaire;
+
+/**
+ * \brief La position dans la source d'un noeud dont les enfants sont
+ *        matrialiss  la demande.
+ *
+ * Une fois matrialiss, les 'nombre' noeuds du morceau peuvent tre vincs
+ * tant qu'aucun d'eux n'a t 'modifie', qu'aucun n'est retenu par les
+ * 'epingles' et que les 'englobes' morceaux matrialiss sous lui ont t
+ * vincs. L''englobant' est le morceau qui contient le 'noeud'.
+ *
+ * Le descripteur est dsallou lorsque son 'noeud', son bloc et les
+ * descripteurs qu'il englobe ont tous retir leur lien.
+ */
+typedef struct differe_arbre_binaire_struct {
+	source_arbre_binaire* source;
+	arbre_binaire* noeud;
+	struct differe_arbre_binaire_struct* englobant;
+	size_t liens;
+	size_t position;
+	size_t nombre;
+	size_t englobes;
+	size_t epingles;
+	atomic_bool materialise;
+	bool modifie;
+	unsigned long generation;
+	struct differe_arbre_binaire_struct* plus_ancien;
+	struct differe_arbre_binaire_struct* plus_recent;
+} differe_arbre_binaire;
+
+/**
+ * \brief File des arbres  dsallouer par un fil d'excution spar.
+ */
+struct recuperateur_arbre_binaire_struct {
+	pthread_t fil;
+	pthread_mutex_t verrou;
+	pthread_cond_t condition_ajout;
+	pthread_cond_t condition_retrait;
+	arbre_binaire** file;
+	int capacite;
+	int debut;
+	int nombre;
+	int en_cours;
+	bool arret;
+};
+
+/**
+ * \brief Un fichier  lire ou  crire dans un lot.
+ */
+typedef struct fichier_lot_arbre_binaire_struct {
+	arbre_binaire* arbre;
+	char* nom_fichier;
+	int etape;
+	int descripteur;
+	char* tampon;
+	size_t taille;
+	size_t fait;
+	const char* erreur;
+} fichier_lot_arbre_binaire;
+
+/**
+ * \brief Un lot de fichiers  lire ou  crire.
+ */
+typedef struct lot_arbre_binaire_struct {
+	fichier_lot_arbre_binaire* fichiers;
+	int nombre;
+	bool ecriture;
+	atomic_int suivant;
+} lot_arbre_binaire;
+
+#ifdef ARBRE_BINAIRE_IO_URING
+/**
+ * \brief Les files de soumission et de compltion d'un io_uring.
+ */
+typedef struct anneau_arbre_binaire_struct {
+	int descripteur;
+	unsigned int entrees;
+	unsigned int* soumission_tete;
+	unsigned int* soumission_queue;
+	unsigned int* soumission_masque;
+	unsigned int* soumission_tableau;
+	struct io_uring_sqe* soumissions;
+	unsigned int* completion_tete;
+	unsigned int* completion_queue;
+	unsigned int* completion_masque;
+	struct io_uring_cqe* completions;
+	void* region_soumission;
+	size_t taille_soumission;
+	void* region_completion;
+	size_t taille_completion;
+	size_t taille_soumissions;
+} anneau_arbre_binaire;
+#endif
+
+/**
+ * \brief Les noeuds d'un arbre numrots dans l'ordre prfixe et les
+ *        structures qui retrouvent le moins profond d'un intervalle.
+ *
+ * Les noeuds sont groups en blocs de BLOC_ANCETRES. Le bit j du masque
+ * d'un noeud est actif si le noeud j de son bloc, plac avant lui ou
+ * lui-mme, est strictement moins profond que tous les noeuds qui le
+ * suivent jusqu'au noeud du masque. La 'table' creuse ne porte que sur le
+ * noeud le moins profond de chacun des 'nombre_blocs' blocs.
+ */
+struct ancetres_arbre_binaire_struct {
+	taille_arbre_binaire nombre;
+	arbre_binaire** noeuds;
+	taille_arbre_binaire* profondeurs;
+	taille_arbre_binaire* parents;
+	taille_arbre_binaire* sorties;
+	uint64_t* masques;
+	taille_arbre_binaire nombre_blocs;
+	taille_arbre_binaire* table;
+	arbre_binaire** index;
+	taille_arbre_binaire* numeros_index;
+	size_t capacite_index;
+};
+
+/**
+ * \brief Un noeud en attente d'tre numrot.
+ */
+typedef struct parcours_ancetres_arbre_binaire_struct {
+	arbre_binaire* noeud;
+	taille_arbre_binaire parent;
+	taille_arbre_binaire profondeur;
+} parcours_ancetres_arbre_binaire;
+
+/**
+ * \brief Un noeud dont le hachage est en cours de calcul. L''etape' indique
+ *        combien de ses enfants ont t hachs.
+ */
+typedef struct parcours_hachage_arbre_binaire_struct {
+	arbre_binaire* noeud;
+	int etape;
+	uint64_t hachage_premier_enfant;
+} parcours_hachage_arbre_binaire;
+
+/**
+ * \brief L'emplacement d'un noeud en cours de partage. L''etape' indique
+ *        combien de ses enfants ont t parcourus.
+ */
+typedef struct parcours_partage_arbre_binaire_struct {
+	arbre_binaire** emplacement;
+	int etape;
+} parcours_partage_arbre_binaire;
+
+/**
+ * \brief Table des noeuds uniques utilise lors du partage des sous-arbres.
+ */
+struct table_partage_arbre_binaire_struct {
+	arbre_binaire** noeuds;
+	size_t capacite;
+	size_t nombre;
 };
 
+/**
+ * \brief Traitement appliqu  un bloc contigu de valeurs.
+ */
+typedef void (*noyau_arbre_binaire)(valeur_arbre_binaire* valeurs,
+		size_t nombre, void* donnees);
+
+/**
+ * \brief Les paramtres d'une transformation affine des valeurs.
+ */
+typedef struct affine_arbre_binaire_struct {
+	valeur_arbre_binaire facteur;
+	valeur_arbre_binaire decalage;
+} affine_arbre_binaire;
+
+/**
+ * \brief La table de remplacement des valeurs entre 0 et 'nombre'.
+ */
+typedef struct remplacement_arbre_binaire_struct {
+	const valeur_arbre_binaire* table;
+	taille_arbre_binaire nombre;
+} remplacement_arbre_binaire;
+
+/**
+ * \brief La somme, la plus petite et la plus grande des valeurs.
+ */
+typedef struct resume_arbre_binaire_struct {
+	int64_t somme;
+	valeur_arbre_binaire minimum;
+	valeur_arbre_binaire maximum;
+} resume_arbre_binaire;
+
+/**
+ * \brief Les intervalles de valeurs compts par un histogramme.
+ */
+typedef struct intervalles_arbre_binaire_struct {
+	valeur_arbre_binaire minimum;
+	valeur_arbre_binaire largeur;
+	taille_arbre_binaire* compteurs;
+	taille_arbre_binaire nombre;
+} intervalles_arbre_binaire;
+
+/**
+ *  \brief Indique que les morceaux chargs paresseusement qui contiennent
+ *         l''arbre' ont t modifis et ne peuvent plus tre vincs.
+ *
+ *  La remonte s'arrte au premier morceau dj modifi puisque tous ceux
+ *  qui le contiennent le sont forcment aussi.
+ *
+ *  \param arbre L'arbre_binaire qui a t modifi
+ */
+void marquer_modifie_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_noeud = a_arbre;
+	bool l_fin = false;
+	while (l_noeud && !l_fin) {
+		if (l_noeud->differe) {
+			l_fin = l_noeud->differe->modifie;
+			l_noeud->differe->modifie = true;
+		}
+		l_noeud = l_noeud->parent;
+	}
+}
+
+/**
+ *  \brief Invalide le hachage de l''arbre' et de tous ses parents.
+ *
+ *  La remonte s'arrte au premier noeud dont le hachage est dj invalide
+ *  puisque tous ses parents le sont forcment aussi.
+ *
+ *  \param arbre L'arbre_binaire qui a t modifi
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void invalider_hachage_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_noeud = a_arbre;
+	if (a_arbre->paresseux) {
+		marquer_modifie_arbre_binaire(a_arbre);
+	}
+	while (l_noeud && l_noeud->hachage_valide) {
+		l_noeud->hachage_valide = false;
+		l_noeud = l_noeud->parent;
+	}
+}
+
+/**
+ *  \brief Indique que l''arbre' et tous ses descendants sont partags.
+ *
+ *  Le parcours utilise les parents puisque les noeuds non partags n'ont
+ *  qu'un seul parent. Les sous-arbres dj partags ne sont pas parcourus.
+ *
+ *  \param arbre L'arbre_binaire  marquer
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void marquer_partage_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_noeud = a_arbre;
+	bool l_fin = a_arbre->partage;
+	a_arbre->partage = true;
+	while (!l_fin) {
+		if (l_noeud->premier_enfant && !l_noeud->premier_enfant->partage) {
+			l_noeud = l_noeud->premier_enfant;
+			l_noeud->partage = true;
+		} else if (l_noeud->second_enfant &&
+				!l_noeud->second_enfant->partage) {
+			l_noeud = l_noeud->second_enfant;
+			l_noeud->partage = true;
+		} else if (l_noeud == a_arbre) {
+			l_fin = true;
+		} else {
+			l_noeud = l_noeud->parent;
+		}
+	}
+}
+
+/**
+ *  \brief Ajoute une rfrence  l''arbre', qui devient partag.
+ *
+ *  \param arbre L'arbre_binaire  partager
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void ajouter_reference_arbre_binaire(arbre_binaire* a_arbre)
+{
+	atomic_fetch_add(&a_arbre->references, 1);
+	marquer_partage_arbre_binaire(a_arbre);
+	a_arbre->parent = NULL;
+}
+
+/**
+ *  \brief Indique si l''arbre' peut tre modifi sur place et inscrit
+ *         l'erreur dans l''arbre' sinon.
+ *
+ *  \param arbre L'arbre_binaire  modifier
+ *
+ *  \return true si l''arbre' n'est pas partag, false sinon.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool verifier_modifiable_arbre_binaire(arbre_binaire* a_arbre)
+{
+	if (a_arbre->partage) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"L'arbre est partag et ne peut pas tre modifi.");
+	}
+	return !a_arbre->partage;
+}
+
+/**
+ *  \brief Initialise un noeud sans enfant.
+ *
+ *  \param arbre Le noeud  initialiser
+ *  \param valeur La valeur du noeud
+ *  \param bloc Le bloc qui contient le noeud ou NULL
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void initialiser_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_valeur,
+		bloc_arbre_binaire* a_bloc)
+{
+	a_arbre->premier_enfant = NULL;
+	a_arbre->second_enfant = NULL;
+	a_arbre->parent = NULL;
+	a_arbre->valeur = a_valeur;
+	a_arbre->a_erreur = false;
+	a_arbre->hachage_valide = false;
+	atomic_init(&a_arbre->references, 1);
+	a_arbre->partage = false;
+	a_arbre->erreur = NULL;
+	a_arbre->bloc = a_bloc;
+	a_arbre->differe = NULL;
+	a_arbre->paresseux = false;
+}
+
 /**
  *  \brief Crer un nouvel arbre binaire.
  *  
@@ -62,499 +553,4960 @@ struct arbre_binaire_struct {
  *
  *  \return L'arbre binaire
  */
-arbre_binaire* creer_arbre_binaire(int a_valeur)
+arbre_binaire* creer_arbre_binaire(valeur_arbre_binaire a_valeur)
 {
 	arbre_binaire* l_result;
 	l_result = calloc(1, sizeof(arbre_binaire));
 	if (l_result) {
-		l_result->premier_enfant = NULL;
-		l_result->second_enfant = NULL;
-		l_result->valeur = a_valeur;
-		l_result->a_erreur = false;
-        l_result->erreur = calloc(ERREUR_TAILLE, sizeof(char));
+		initialiser_arbre_binaire(l_result, a_valeur, NULL);
 	}
 	return l_result;
 }
 
 /**
- *  \brief Lire dans un fichier un arbre binaire
- *  
- *  \param arbre L'arbre_binaire  lire du fichier
- *  \param fichier Le fichier  lire
+ *  \brief Retire le 'differe' de la liste des morceaux matrialiss de sa
+ *         source.
+ *
+ *  \param differe Le descripteur  retirer
+ *
+ *  \note Le verrou de la source doit tre obtenu
  */
-void lire_arbre_binaire(arbre_binaire* a_arbre, FILE* a_fichier)
+void retirer_liste_differe_arbre_binaire(differe_arbre_binaire* a_differe)
 {
-	int l_contenu[3];
-	fread(l_contenu, sizeof(int), 3, a_fichier);
-	modifier_element_arbre_binaire(a_arbre, l_contenu[0]);
-	if (l_contenu[1] == 1) {
-		creer_premier_enfant_arbre_binaire(a_arbre, 0);
-		lire_arbre_binaire(a_arbre->premier_enfant, a_fichier);
+	source_arbre_binaire* l_source = a_differe->source;
+	if (a_differe->plus_ancien) {
+		a_differe->plus_ancien->plus_recent = a_differe->plus_recent;
+	} else {
+		l_source->plus_ancien = a_differe->plus_recent;
 	}
-	if (l_contenu[2] == 1) {
-		creer_second_enfant_arbre_binaire(a_arbre, 0);
-		lire_arbre_binaire(a_arbre->second_enfant, a_fichier);
+	if (a_differe->plus_recent) {
+		a_differe->plus_recent->plus_ancien = a_differe->plus_ancien;
+	} else {
+		l_source->plus_recent = a_differe->plus_ancien;
 	}
+	a_differe->plus_ancien = NULL;
+	a_differe->plus_recent = NULL;
 }
 
 /**
- *  \brief Crer un nouvel arbre_binaire depuis un fichier.
+ *  \brief Place le 'differe'  la fin de la liste des morceaux matrialiss
+ *         de sa source, avec les morceaux utiliss le plus rcemment.
  *
- *  Crer un nouvel liste_tableau et charge le contenue du fichier
- *  'nom_fichier' dans l'arbre. Si le fichier n'est pas valide, indique
- *  l'erreur dans 'arbre'->'erreur'.
+ *  \param differe Le descripteur  placer
  *
- *  \param nom_fichier Le nom du fichier contenant l'arbre
+ *  \note Le verrou de la source doit tre obtenu
+ */
+void toucher_differe_arbre_binaire(differe_arbre_binaire* a_differe)
+{
+	source_arbre_binaire* l_source = a_differe->source;
+	if (l_source->plus_recent != a_differe) {
+		if (a_differe->plus_ancien || a_differe->plus_recent ||
+				l_source->plus_ancien == a_differe) {
+			retirer_liste_differe_arbre_binaire(a_differe);
+		}
+		a_differe->plus_ancien = l_source->plus_recent;
+		if (l_source->plus_recent) {
+			l_source->plus_recent->plus_recent = a_differe;
+		} else {
+			l_source->plus_ancien = a_differe;
+		}
+		l_source->plus_recent = a_differe;
+	}
+}
+
+/**
+ *  \brief Indique si le morceau du 'differe' peut tre vinc.
  *
- *  \return L'arbre_binaire
+ *  \param differe Le descripteur du morceau
  *
- *  \note Le fichier doit tre cr  l'aide de la routine 
- *  sauvegarder_arbre_binaire
+ *  \return true si le morceau peut tre vinc, false sinon.
+ *
+ *  \note Le verrou de la source doit tre obtenu
  */
-arbre_binaire* charger_arbre_binaire(char* a_nom_fichier)
+bool evincable_differe_arbre_binaire(differe_arbre_binaire* a_differe)
 {
-	FILE* l_fichier;
-	l_fichier = fopen(a_nom_fichier, "rb");
-	arbre_binaire* l_result = creer_arbre_binaire(0);
-	if (l_fichier) {
-		lire_arbre_binaire(l_result, l_fichier);
-		fclose(l_fichier);
-	} else {
-		inscrire_erreur_arbre_binaire(l_result, 
-			"Ne peux pas ouvrir le fichier en lecture.");
+	return atomic_load(&a_differe->materialise) && !a_differe->modifie &&
+		a_differe->englobes == 0 && a_differe->epingles == 0;
+}
+
+/**
+ *  \brief Crer un descripteur qui rfrence la 'source'.
+ *
+ *  \param source La source du chargement paresseux
+ *  \param englobant Le morceau qui contient le noeud du descripteur ou NULL
+ *
+ *  \return Le descripteur ou NULL si la mmoire a manqu
+ *
+ *  \note Le verrou de la 'source' doit tre obtenu
+ */
+differe_arbre_binaire* creer_differe_arbre_binaire(
+		source_arbre_binaire* a_source, differe_arbre_binaire* a_englobant)
+{
+	differe_arbre_binaire* l_result = calloc(1, sizeof(differe_arbre_binaire));
+	if (l_result) {
+		l_result->source = a_source;
+		l_result->englobant = a_englobant;
+		l_result->liens = 1;
+		atomic_init(&l_result->materialise, false);
+		a_source->references = a_source->references + 1;
+		if (a_englobant) {
+			a_englobant->liens = a_englobant->liens + 1;
+		}
 	}
 	return l_result;
 }
 
 /**
- *  \brief Effectue la dsallocation d'un arbre_binaire
+ *  \brief Retire un lien du 'differe' et le dsalloue, ainsi que sa source,
+ *         lorsqu'il en tait le dernier.
  *
- *  \param arbre L'arbre_binaire  dsallouer
+ *  \param differe Le descripteur
  */
-void detruire_arbre_binaire(arbre_binaire* a_arbre)
+void retirer_lien_differe_arbre_binaire(differe_arbre_binaire* a_differe)
 {
-	if (a_arbre->premier_enfant) {
-		detruire_arbre_binaire(a_arbre->premier_enfant);
-		a_arbre->premier_enfant = NULL;
+	source_arbre_binaire* l_source = a_differe->source;
+	differe_arbre_binaire* l_differe = a_differe;
+	differe_arbre_binaire* l_englobant;
+	bool l_dernier;
+	pthread_mutex_lock(&l_source->verrou);
+	while (l_differe) {
+		l_differe->liens = l_differe->liens - 1;
+		l_englobant = NULL;
+		if (l_differe->liens == 0) {
+			l_englobant = l_differe->englobant;
+			free(l_differe);
+			l_source->references = l_source->references - 1;
+		}
+		l_differe = l_englobant;
 	}
-	if (a_arbre->second_enfant) {
-		detruire_arbre_binaire(a_arbre->second_enfant);
-		a_arbre->second_enfant = NULL;
+	l_dernier = l_source->references == 0;
+	pthread_mutex_unlock(&l_source->verrou);
+	if (l_dernier) {
+		pthread_mutex_destroy(&l_source->verrou);
+		munmap(l_source->contenu - l_source->entete,
+			l_source->taille + l_source->entete);
+		free(l_source->fins);
+		free(l_source->attentes);
+		free(l_source);
 	}
-	free(a_arbre->erreur);
-	free(a_arbre);
 }
 
 /**
- *  \brief crit dans un fichier un arbre binaire
- *  
- *  \param arbre L'arbre_binaire  crire dans le fichier
- *  \param fichier Le fichier  crire
+ *  \brief Retire le morceau du 'differe' des morceaux matrialiss lorsque
+ *         son noeud est dsallou, puis retire le lien du noeud.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param differe Le descripteur du noeud dsallou
  */
-void ecrire_arbre_binaire(arbre_binaire* a_arbre, FILE* a_fichier)
+void detruire_differe_source_arbre_binaire(differe_arbre_binaire* a_differe)
 {
-	int l_contenu[3];
-	l_contenu[0] = a_arbre->valeur;
-	if (a_arbre->premier_enfant) {
-		l_contenu[1] = 1;
-	} else {
-		l_contenu[1] = 0;
+	source_arbre_binaire* l_source = a_differe->source;
+	differe_arbre_binaire* l_englobant = a_differe->englobant;
+	pthread_mutex_lock(&l_source->verrou);
+	if (atomic_load(&a_differe->materialise)) {
+		retirer_liste_differe_arbre_binaire(a_differe);
+		atomic_store(&a_differe->materialise, false);
+		l_source->residents = l_source->residents - a_differe->nombre;
+		if (l_englobant) {
+			l_englobant->englobes = l_englobant->englobes - 1;
+			if (evincable_differe_arbre_binaire(l_englobant)) {
+				toucher_differe_arbre_binaire(l_englobant);
+			}
+		}
 	}
-	if (a_arbre->second_enfant) {
-		l_contenu[2] = 1;
-	} else {
-		l_contenu[2] = 0;
+	a_differe->noeud = NULL;
+	pthread_mutex_unlock(&l_source->verrou);
+	retirer_lien_differe_arbre_binaire(a_differe);
+}
+
+/**
+ *  \brief Parcourt les enregistrements du sous-arbre plac  la 'position'
+ *         de la 'source' et initialise les noeuds des 'profondeur' premiers
+ *         niveaux sous sa racine.
+ *
+ *  Les noeuds plus profonds sont sauts sans tre lus grce aux 'fins' de
+ *  la 'source'. Les noeuds du dernier niveau qui
+ *  ont des enfants reoivent un des 'differes' afin d'tre matrialiss 
+ *  leur tour lorsqu'ils seront utiliss. Pendant la cration, les
+ *  emplacements d'enfants attendus pointent vers la 'racine'.
+ *
+ *  \param source La source du chargement paresseux
+ *  \param position La position de l'enregistrement de la racine
+ *  \param bloc Le bloc  remplir dans l'ordre prfixe ou NULL pour seulement
+ *              compter les noeuds
+ *  \param racine Le noeud qui reoit les enfants
+ *  \param differes Les descripteurs  donner aux noeuds du dernier niveau
+ *  \param frontiere Reoit le nombre de noeuds du dernier niveau qui ont des
+ *                   enfants
+ *
+ *  \return Le nombre de noeuds des premiers niveaux
+ *
+ *  \note Le contenu de la 'source' doit tre valid par
+ *        'valider_tampon_arbre_binaire'
+ */
+size_t parcourir_differe_arbre_binaire(source_arbre_binaire* a_source,
+		size_t a_position, bloc_arbre_binaire* a_bloc, arbre_binaire* a_racine,
+		differe_arbre_binaire** a_differes, size_t* a_frontiere)
+{
+	size_t l_nombre = 0;
+	size_t l_position = a_position + TAILLE_ENREGISTREMENT;
+	size_t l_debut;
+	int l_niveau = 0;
+	int* l_attentes = a_source->attentes;
+	valeur_arbre_binaire l_contenu[3];
+	arbre_binaire* l_attendu = a_racine;
+	arbre_binaire* l_noeud;
+	arbre_binaire* l_parent = a_racine;
+	*a_frontiere = 0;
+	memcpy(l_contenu, a_source->contenu + a_position, TAILLE_ENREGISTREMENT);
+	l_attentes[0] = l_contenu[1] + l_contenu[2];
+	if (a_bloc) {
+		if (l_contenu[1]) {
+			a_racine->premier_enfant = l_attendu;
+		}
+		if (l_contenu[2]) {
+			a_racine->second_enfant = l_attendu;
+		}
 	}
-	fwrite(l_contenu, sizeof(int), 3, a_fichier);
-	if (a_arbre->premier_enfant) {
-		ecrire_arbre_binaire(a_arbre->premier_enfant, a_fichier);
+	while (l_niveau >= 0) {
+		if (l_attentes[l_niveau] == 0) {
+			l_niveau = l_niveau - 1;
+		} else {
+			l_attentes[l_niveau] = l_attentes[l_niveau] - 1;
+			l_debut = l_position;
+			memcpy(l_contenu, a_source->contenu + l_position,
+				TAILLE_ENREGISTREMENT);
+			l_position = l_position + TAILLE_ENREGISTREMENT;
+			if (a_bloc) {
+				l_noeud = &a_bloc->noeuds[l_nombre];
+				initialiser_arbre_binaire(l_noeud, l_contenu[0], a_bloc);
+				l_noeud->paresseux = true;
+				l_noeud->partage = a_racine->partage;
+				if (l_niveau + 1 < a_source->profondeur) {
+					if (l_contenu[1]) {
+						l_noeud->premier_enfant = l_attendu;
+					}
+					if (l_contenu[2]) {
+						l_noeud->second_enfant = l_attendu;
+					}
+				} else if (l_contenu[1] || l_contenu[2]) {
+					l_noeud->differe = a_differes[*a_frontiere];
+					l_noeud->differe->noeud = l_noeud;
+					l_noeud->differe->position = l_debut;
+				}
+				while (l_parent->premier_enfant != l_attendu &&
+						l_parent->second_enfant != l_attendu) {
+					l_parent = l_parent->parent;
+				}
+				if (l_parent->premier_enfant == l_attendu) {
+					l_parent->premier_enfant = l_noeud;
+				} else {
+					l_parent->second_enfant = l_noeud;
+				}
+				l_noeud->parent = l_parent;
+				l_parent = l_noeud;
+			}
+			l_nombre = l_nombre + 1;
+			if (l_niveau + 1 < a_source->profondeur) {
+				l_niveau = l_niveau + 1;
+				l_attentes[l_niveau] = l_contenu[1] + l_contenu[2];
+			} else {
+				if (l_contenu[1] || l_contenu[2]) {
+					*a_frontiere = *a_frontiere + 1;
+				}
+				l_position = a_source->fins[l_debut / TAILLE_ENREGISTREMENT] *
+					TAILLE_ENREGISTREMENT;
+			}
+		}
 	}
-	if (a_arbre->second_enfant) {
-		ecrire_arbre_binaire(a_arbre->second_enfant, a_fichier);
+	return l_nombre;
+}
+
+/**
+ *  \brief vince les morceaux non modifis les moins rcemment utiliss
+ *         jusqu' ce que la 'source' respecte son budget.
+ *
+ *  Seuls les morceaux sous lesquels aucun morceau n'est matrialis sont
+ *  vincs, ce qui protge les morceaux qui contiennent le noeud en cours
+ *  d'utilisation. Les morceaux pingls ou touchs depuis la dernire
+ *  matrialisation sont conservs. Les morceaux qui ne peuvent pas tre
+ *  vincs sont retirs de la liste et y sont replacs lorsqu'ils le
+ *  redeviennent, ce qui vite de les parcourir  chaque viction.
+ *
+ *  \param source La source du chargement paresseux
+ *
+ *  \note Le verrou de la 'source' doit tre obtenu
+ */
+void evincer_arbre_binaire(source_arbre_binaire* a_source)
+{
+	differe_arbre_binaire* l_differe = a_source->plus_ancien;
+	differe_arbre_binaire* l_suivant;
+	differe_arbre_binaire* l_englobant;
+	arbre_binaire* l_noeud;
+	arbre_binaire* l_premier_enfant;
+	arbre_binaire* l_second_enfant;
+	while (a_source->budget > 0 && a_source->residents > a_source->budget &&
+			l_differe) {
+		l_suivant = l_differe->plus_recent;
+		if (!evincable_differe_arbre_binaire(l_differe)) {
+			retirer_liste_differe_arbre_binaire(l_differe);
+		} else if (l_differe->generation != a_source->generation) {
+			l_noeud = l_differe->noeud;
+			l_premier_enfant = l_noeud->premier_enfant;
+			l_second_enfant = l_noeud->second_enfant;
+			l_noeud->premier_enfant = NULL;
+			l_noeud->second_enfant = NULL;
+			retirer_liste_differe_arbre_binaire(l_differe);
+			atomic_store(&l_differe->materialise, false);
+			a_source->residents = a_source->residents - l_differe->nombre;
+			l_differe->nombre = 0;
+			l_englobant = l_differe->englobant;
+			if (l_englobant) {
+				l_englobant->englobes = l_englobant->englobes - 1;
+				if (evincable_differe_arbre_binaire(l_englobant)) {
+					toucher_differe_arbre_binaire(l_englobant);
+				}
+			}
+			if (l_premier_enfant) {
+				detruire_arbre_binaire(l_premier_enfant);
+			}
+			if (l_second_enfant) {
+				detruire_arbre_binaire(l_second_enfant);
+			}
+			if (!l_suivant) {
+				l_suivant = a_source->plus_recent;
+			}
+		}
+		l_differe = l_suivant;
 	}
 }
 
 /**
- *  \brief Sauvegarder l'arbre_binaire dans un fichier
+ *  \brief Crer le morceau de 'nombre' noeuds plac sous l''arbre' et les
+ *         descripteurs de ses 'frontiere' noeuds en attente.
  *
- *  Sauvegarde le contenue de l''arbre' dans le fichier 'nom_fichier'.
- *  Si le fichier n'est pas valide, indique l'erreur dans 'arbre'->'erreur'.
+ *  Le morceau devient le plus rcemment utilis et les plus anciens peuvent
+ *  tre vincs pour respecter le budget de la source.
  *
- *  \param arbre L'arbre_binaire
- *  \param nom_fichier Le nom du fichier  sauvegarder l'arbre
+ *  \param arbre L'arbre_binaire dont les enfants sont matrialiss
+ *  \param nombre Le nombre de noeuds du morceau
+ *  \param frontiere Le nombre de noeuds du morceau qui restent en attente
+ *  \param valide Faux si le 'nombre' ne peut pas tre allou
+ *
+ *  \note Le verrou de la source de l''arbre' doit tre obtenu
+ */
+void materialiser_morceau_arbre_binaire(arbre_binaire* a_arbre,
+		size_t a_nombre, size_t a_frontiere, bool a_valide)
+{
+	differe_arbre_binaire* l_differe = a_arbre->differe;
+	source_arbre_binaire* l_source = l_differe->source;
+	bloc_arbre_binaire* l_bloc = NULL;
+	differe_arbre_binaire** l_differes = NULL;
+	size_t l_i;
+	bool l_valide = a_valide;
+	if (l_valide && a_nombre > 0) {
+		l_bloc = malloc(sizeof(bloc_arbre_binaire) +
+			a_nombre * sizeof(arbre_binaire));
+		l_differes = calloc(a_frontiere + 1, sizeof(differe_arbre_binaire*));
+		l_valide = l_bloc && l_differes;
+	}
+	for (l_i = 0; l_valide && l_i < a_frontiere; l_i = l_i + 1) {
+		l_differes[l_i] = creer_differe_arbre_binaire(l_source, l_differe);
+		l_valide = l_differes[l_i] != NULL;
+	}
+	if (l_valide) {
+		if (l_bloc) {
+			atomic_init(&l_bloc->vivants, a_nombre);
+			l_bloc->differe = l_differe;
+			l_differe->liens = l_differe->liens + 1;
+			parcourir_differe_arbre_binaire(l_source, l_differe->position,
+				l_bloc, a_arbre, l_differes, &a_frontiere);
+		}
+		l_differe->modifie = false;
+		l_differe->nombre = a_nombre;
+		l_source->residents = l_source->residents + a_nombre;
+		l_source->generation = l_source->generation + 1;
+		l_differe->generation = l_source->generation;
+		if (l_differe->englobant) {
+			l_differe->englobant->englobes =
+				l_differe->englobant->englobes + 1;
+		}
+		toucher_differe_arbre_binaire(l_differe);
+		atomic_store(&l_differe->materialise, true);
+		evincer_arbre_binaire(l_source);
+	} else {
+		for (l_i = 0; l_differes && l_differes[l_i]; l_i = l_i + 1) {
+			free(l_differes[l_i]);
+			l_source->references = l_source->references - 1;
+			l_differe->liens = l_differe->liens - 1;
+		}
+		free(l_bloc);
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire.");
+	}
+	free(l_differes);
+}
+
+/**
+ *  \brief Matrialise depuis le fichier les enfants de l''arbre' s'ils n'ont
+ *         pas encore t chargs.
+ *
+ *  \param arbre L'arbre_binaire dont les enfants sont utiliss
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void materialiser_arbre_binaire(arbre_binaire* a_arbre)
+{
+	differe_arbre_binaire* l_differe = a_arbre->differe;
+	source_arbre_binaire* l_source;
+	size_t l_nombre;
+	size_t l_frontiere;
+	if (l_differe && !atomic_load(&l_differe->materialise)) {
+		l_source = l_differe->source;
+		pthread_mutex_lock(&l_source->verrou);
+		if (!atomic_load(&l_differe->materialise)) {
+			l_nombre = parcourir_differe_arbre_binaire(l_source,
+				l_differe->position, NULL, a_arbre, NULL, &l_frontiere);
+			materialiser_morceau_arbre_binaire(a_arbre, l_nombre, l_frontiere,
+				l_nombre <= (SIZE_MAX - sizeof(bloc_arbre_binaire)) /
+				sizeof(arbre_binaire));
+		}
+		pthread_mutex_unlock(&l_source->verrou);
+	}
+}
+
+/**
+ *  \brief Retourne la source de l''arbre' s'il a t charg paresseusement.
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return La source de l''arbre' ou NULL
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+source_arbre_binaire* trouver_source_arbre_binaire(arbre_binaire* a_arbre)
+{
+	source_arbre_binaire* l_result = NULL;
+	if (a_arbre->differe) {
+		l_result = a_arbre->differe->source;
+	} else if (a_arbre->bloc && a_arbre->bloc->differe) {
+		l_result = a_arbre->bloc->differe->source;
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Matrialise les enfants de l''arbre' et en fait le morceau le plus
+ *         rcemment utilis.
+ *
+ *  \param arbre L'arbre_binaire dont les enfants sont utiliss
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void utiliser_arbre_binaire(arbre_binaire* a_arbre)
+{
+	materialiser_arbre_binaire(a_arbre);
+	if (a_arbre->differe && atomic_load(&a_arbre->differe->materialise)) {
+		pthread_mutex_lock(&a_arbre->differe->source->verrou);
+		toucher_differe_arbre_binaire(a_arbre->differe);
+		pthread_mutex_unlock(&a_arbre->differe->source->verrou);
+	}
+}
+
+/**
+ *  \brief Retourne l'enfant plac dans l'emplacement 'enfant' de l''arbre'
+ *         en pinglant le morceau qui le contient.
+ *
+ *  Le morceau ne peut pas tre vinc tant que l'enfant n'a pas t relch
+ *  par 'relacher_arbre_binaire'.
+ *
+ *  \param arbre L'arbre_binaire qui contient l'enfant
+ *  \param enfant L'emplacement de l'enfant dans l''arbre'
+ *
+ *  \return L'enfant ou NULL si l'emplacement est vide
+ *
+ *  \note 'arbre' et 'enfant' ne doivent pas tre NULL
+ */
+arbre_binaire* enfant_epingle_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire** a_enfant)
+{
+	arbre_binaire* l_result;
+	source_arbre_binaire* l_source = trouver_source_arbre_binaire(a_arbre);
+	if (l_source) {
+		pthread_mutex_lock(&l_source->verrou);
+	}
+	utiliser_arbre_binaire(a_arbre);
+	l_result = *a_enfant;
+	if (l_result && l_result->bloc && l_result->bloc->differe) {
+		l_result->bloc->differe->epingles =
+			l_result->bloc->differe->epingles + 1;
+	}
+	if (l_source) {
+		pthread_mutex_unlock(&l_source->verrou);
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Matrialise tout l''arbre' et empche l'viction de ses morceaux.
+ *
+ *  Utilis avant les oprations qui rorganisent les noeuds ou qui
+ *  conservent des pointeurs vers eux.
+ *
+ *  \param arbre L'arbre_binaire  matrialiser
+ *
+ *  \return true si la matrialisation a russi, false si la mmoire a manqu.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool materialiser_tout_arbre_binaire(arbre_binaire* a_arbre)
+{
+	bool l_result = true;
+	taille_arbre_binaire l_capacite = 64;
+	taille_arbre_binaire l_taille = 1;
+	arbre_binaire** l_pile = malloc(l_capacite * sizeof(arbre_binaire*));
+	arbre_binaire* l_noeud;
+	void* l_nouveau;
+	if (l_pile) {
+		l_pile[0] = a_arbre;
+	} else {
+		l_taille = 0;
+		l_result = false;
+	}
+	while (l_taille > 0) {
+		l_taille = l_taille - 1;
+		l_noeud = l_pile[l_taille];
+		if (l_noeud->differe) {
+			materialiser_arbre_binaire(l_noeud);
+			l_noeud->differe->modifie = true;
+			if (!atomic_load(&l_noeud->differe->materialise)) {
+				l_taille = 0;
+				l_result = false;
+			}
+		}
+		if (l_result && l_taille + 2 > l_capacite) {
+			l_nouveau = realloc(l_pile,
+				l_capacite * 2 * sizeof(arbre_binaire*));
+			if (l_nouveau) {
+				l_pile = l_nouveau;
+				l_capacite = l_capacite * 2;
+			} else {
+				l_taille = 0;
+				l_result = false;
+			}
+		}
+		if (l_result && l_noeud->premier_enfant) {
+			l_pile[l_taille] = l_noeud->premier_enfant;
+			l_taille = l_taille + 1;
+		}
+		if (l_result && l_noeud->second_enfant) {
+			l_pile[l_taille] = l_noeud->second_enfant;
+			l_taille = l_taille + 1;
+		}
+	}
+	free(l_pile);
+	return l_result;
+}
+
+/**
+ *  \brief Crer un nouvel arbre_binaire depuis un fichier.
+ *
+ *  Crer un nouvel liste_tableau et charge le contenue du fichier
+ *  'nom_fichier' dans l'arbre. Si le fichier n'est pas valide, indique
+ *  l'erreur dans 'arbre'->'erreur'.
+ *
+ *  \param nom_fichier Le nom du fichier contenant l'arbre
+ *
+ *  \return L'arbre_binaire
+ *
+ *  \note Le fichier doit tre cr  l'aide de la routine 
+ *  sauvegarder_arbre_binaire
+ */
+arbre_binaire* charger_arbre_binaire(char* a_nom_fichier)
+{
+	arbre_binaire* l_result = NULL;
+	int l_fichier = open(a_nom_fichier, O_RDONLY);
+	struct stat l_etat;
+	char* l_contenu = MAP_FAILED;
+	char* l_tampon = NULL;
+	size_t l_lus = 0;
+	ssize_t l_lecture = 1;
+	const char* l_erreur = NULL;
+	if (l_fichier >= 0 && fstat(l_fichier, &l_etat) == 0) {
+		if (l_etat.st_size > 0) {
+			l_contenu = mmap(NULL, l_etat.st_size, PROT_READ, MAP_PRIVATE,
+				l_fichier, 0);
+		}
+		if (l_contenu != MAP_FAILED) {
+			madvise(l_contenu, l_etat.st_size, MADV_SEQUENTIAL);
+			l_result = deserialiser_arbre_binaire(l_contenu, l_etat.st_size);
+			munmap(l_contenu, l_etat.st_size);
+		} else {
+			l_tampon = malloc(l_etat.st_size + 1);
+			while (l_tampon && l_lecture > 0 &&
+					l_lus < (size_t)l_etat.st_size) {
+				l_lecture = read(l_fichier, l_tampon + l_lus,
+					l_etat.st_size - l_lus);
+				if (l_lecture > 0) {
+					l_lus = l_lus + l_lecture;
+				}
+			}
+			if (!l_tampon) {
+				l_erreur = "Ne peux pas allouer la mmoire.";
+			} else if (l_lecture < 0) {
+				l_erreur = "Ne peux pas lire le fichier.";
+			} else {
+				l_result = deserialiser_arbre_binaire(l_tampon, l_lus);
+			}
+			free(l_tampon);
+		}
+		if (!l_result && !l_erreur) {
+			l_erreur = "Ne peux pas allouer la mmoire.";
+		}
+	} else {
+		l_erreur = "Ne peux pas ouvrir le fichier en lecture.";
+	}
+	if (l_erreur) {
+		l_result = creer_arbre_binaire(0);
+		if (l_result) {
+			inscrire_erreur_arbre_binaire(l_result, l_erreur);
+		}
+	}
+	if (l_fichier >= 0) {
+		close(l_fichier);
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Effectue la dsallocation d'un arbre_binaire
+ *
+ *  Si l''arbre' est partag, seule la rfrence est retire.
+ *
+ *  \param arbre L'arbre_binaire  dsallouer
+ */
+void detruire_arbre_binaire(arbre_binaire* a_arbre)
+{
+	if (atomic_fetch_sub(&a_arbre->references, 1) == 1) {
+		if (a_arbre->premier_enfant) {
+			detruire_arbre_binaire(a_arbre->premier_enfant);
+			a_arbre->premier_enfant = NULL;
+		}
+		if (a_arbre->second_enfant) {
+			detruire_arbre_binaire(a_arbre->second_enfant);
+			a_arbre->second_enfant = NULL;
+		}
+		free(a_arbre->erreur);
+		if (a_arbre->differe) {
+			detruire_differe_source_arbre_binaire(a_arbre->differe);
+		}
+		if (!a_arbre->bloc) {
+			free(a_arbre);
+		} else if (atomic_fetch_sub(&a_arbre->bloc->vivants, 1) == 1) {
+			if (a_arbre->bloc->differe) {
+				retirer_lien_differe_arbre_binaire(a_arbre->bloc->differe);
+			}
+			free(a_arbre->bloc);
+		}
+	}
+}
+
+/**
+ *  \brief Calcule le nombre d'lments et la hauteur de l''arbre' sans
+ *         appel rcursif.
+ *
+ *  \param arbre L'arbre_binaire
+ *  \param nombre Reoit le nombre d'lments de l''arbre'
+ *  \param hauteur Reoit la hauteur de l''arbre'
+ *
+ *  \return true si le calcul a russi, false si la mmoire a manqu.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool mesurer_arbre_binaire(arbre_binaire* a_arbre,
+		taille_arbre_binaire* a_nombre, taille_arbre_binaire* a_hauteur)
+{
+	bool l_result = true;
+	taille_arbre_binaire l_capacite = 64;
+	taille_arbre_binaire l_taille = 1;
+	arbre_binaire** l_noeuds = malloc(l_capacite * sizeof(arbre_binaire*));
+	taille_arbre_binaire* l_profondeurs = malloc(l_capacite *
+		sizeof(taille_arbre_binaire));
+	arbre_binaire* l_noeud;
+	taille_arbre_binaire l_profondeur;
+	*a_nombre = 0;
+	*a_hauteur = 0;
+	if (l_noeuds && l_profondeurs) {
+		l_noeuds[0] = a_arbre;
+		l_profondeurs[0] = 1;
+	} else {
+		l_taille = 0;
+		l_result = false;
+	}
+	while (l_taille > 0) {
+		l_taille = l_taille - 1;
+		l_noeud = l_noeuds[l_taille];
+		l_profondeur = l_profondeurs[l_taille];
+		materialiser_arbre_binaire(l_noeud);
+		*a_nombre = *a_nombre + 1;
+		if (l_profondeur > *a_hauteur) {
+			*a_hauteur = l_profondeur;
+		}
+		if (l_taille + 2 > l_capacite) {
+			arbre_binaire** l_nouveaux_noeuds = realloc(l_noeuds,
+				l_capacite * 2 * sizeof(arbre_binaire*));
+			taille_arbre_binaire* l_nouvelles_profondeurs = NULL;
+			if (l_nouveaux_noeuds) {
+				l_noeuds = l_nouveaux_noeuds;
+				l_nouvelles_profondeurs = realloc(l_profondeurs,
+					l_capacite * 2 * sizeof(taille_arbre_binaire));
+			}
+			if (l_nouvelles_profondeurs) {
+				l_profondeurs = l_nouvelles_profondeurs;
+				l_capacite = l_capacite * 2;
+			} else {
+				l_taille = 0;
+				l_result = false;
+			}
+		}
+		if (l_result && l_noeud->premier_enfant) {
+			l_noeuds[l_taille] = l_noeud->premier_enfant;
+			l_profondeurs[l_taille] = l_profondeur + 1;
+			l_taille = l_taille + 1;
+		}
+		if (l_result && l_noeud->second_enfant) {
+			l_noeuds[l_taille] = l_noeud->second_enfant;
+			l_profondeurs[l_taille] = l_profondeur + 1;
+			l_taille = l_taille + 1;
+		}
+	}
+	free(l_noeuds);
+	free(l_profondeurs);
+	return l_result;
+}
+
+/**
+ *  \brief crit l'en-tte du format de srialisation au dbut du 'tampon'.
+ *
+ *  \param tampon Un tampon d'au moins TAILLE_ENTETE octets
+ */
+void ecrire_entete_arbre_binaire(char* a_tampon)
+{
+	memcpy(a_tampon, ENTETE_SIGNATURE, 4);
+	a_tampon[4] = ENTETE_VERSION;
+	a_tampon[5] = sizeof(valeur_arbre_binaire);
+	a_tampon[6] = 0;
+	a_tampon[7] = 0;
+}
+
+/**
+ *  \brief Lit l'en-tte plac au dbut d'un tampon srialis.
+ *
+ *  Un tampon qui ne commence pas par la signature suivie d'une taille de
+ *  valeurs est lu comme un tampon de la version 1 du format, sans en-tte.
+ *  Le sixime octet d'un enregistrement de la version 1 appartient 
+ *  l'indicateur du premier enfant, qui vaut 0 ou 1, et il est donc toujours
+ *  nul.
+ *
+ *  \param tampon Le tampon  lire
+ *  \param taille La taille du 'tampon'
+ *  \param debut Reoit la position du premier enregistrement, soit 0 pour
+ *               la version 1 du format
+ *
+ *  \return Le message d'erreur ou NULL si l'en-tte est valide
+ */
+const char* lire_entete_arbre_binaire(const char* a_tampon, size_t a_taille,
+		size_t* a_debut)
+{
+	const char* l_erreur = NULL;
+	*a_debut = 0;
+	if (a_taille >= TAILLE_ENTETE &&
+			memcmp(a_tampon, ENTETE_SIGNATURE, 4) == 0 &&
+			a_tampon[5] != 0) {
+		*a_debut = TAILLE_ENTETE;
+		if (a_tampon[4] != ENTETE_VERSION) {
+			l_erreur =
+				"La version du format de l'arbre n'est pas supporte.";
+		} else if ((unsigned char)a_tampon[5] !=
+				sizeof(valeur_arbre_binaire)) {
+			l_erreur =
+				"La taille des valeurs de l'arbre n'est pas supporte.";
+		}
+	}
+	return l_erreur;
+}
+
+#ifdef ARBRE_BINAIRE_64
+/**
+ *  \brief Convertit les enregistrements de la version 1 du format en
+ *         enregistrements de 'valeur_arbre_binaire'.
+ *
+ *  Les octets d'un dernier enregistrement incomplet sont recopis tels
+ *  quels afin que la validation signale la mme erreur.
+ *
+ *  \param tampon Les enregistrements de la version 1
+ *  \param taille La taille du 'tampon'
+ *  \param taille_convertie Reoit la taille du tampon retourn
+ *
+ *  \return Le tampon converti,  dsallouer avec free, ou NULL si la
+ *          mmoire a manqu
+ */
+char* convertir_version_1_arbre_binaire(const char* a_tampon,
+		size_t a_taille, size_t* a_taille_convertie)
+{
+	size_t l_nombre = a_taille / TAILLE_ENREGISTREMENT_VERSION_1;
+	size_t l_reste = a_taille % TAILLE_ENREGISTREMENT_VERSION_1;
+	char* l_result;
+	size_t l_i;
+	int l_ancien[3];
+	valeur_arbre_binaire l_contenu[3];
+	*a_taille_convertie = l_nombre * TAILLE_ENREGISTREMENT + l_reste;
+	l_result = malloc(*a_taille_convertie + 1);
+	if (l_result) {
+		for (l_i = 0; l_i < l_nombre; l_i = l_i + 1) {
+			memcpy(l_ancien, a_tampon + l_i * TAILLE_ENREGISTREMENT_VERSION_1,
+				TAILLE_ENREGISTREMENT_VERSION_1);
+			l_contenu[0] = l_ancien[0];
+			l_contenu[1] = l_ancien[1];
+			l_contenu[2] = l_ancien[2];
+			memcpy(l_result + l_i * TAILLE_ENREGISTREMENT, l_contenu,
+				TAILLE_ENREGISTREMENT);
+		}
+		memcpy(l_result + l_nombre * TAILLE_ENREGISTREMENT,
+			a_tampon + l_nombre * TAILLE_ENREGISTREMENT_VERSION_1, l_reste);
+	}
+	return l_result;
+}
+#endif
+
+/**
+ *  \brief crit l'en-tte, s'il y a lieu, puis l''arbre' dans un tampon,
+ *         un noeud  la suite de l'autre dans l'ordre prfixe.
+ *
+ *  \param arbre L'arbre_binaire  crire
+ *  \param tampon Le tampon o crire l''arbre'
+ *  \param capacite La taille du 'tampon'
+ *  \param extensible Si vrai, le 'tampon' est agrandi au besoin avec realloc
+ *
+ *  \return Le nombre d'octets crits ou 0 si le 'tampon' est trop petit ou
+ *          si la mmoire a manqu
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+size_t encoder_arbre_binaire(arbre_binaire* a_arbre, char** a_tampon,
+		size_t* a_capacite, bool a_extensible)
+{
+	size_t l_taille = TAILLE_ENTETE_ECRIT;
+	bool l_valide = true;
+	taille_arbre_binaire l_capacite_pile = 64;
+	taille_arbre_binaire l_pile_taille = 1;
+	arbre_binaire** l_pile = malloc(l_capacite_pile * sizeof(arbre_binaire*));
+	arbre_binaire* l_noeud;
+	valeur_arbre_binaire l_contenu[3];
+	void* l_nouveau;
+	size_t l_nouvelle_capacite;
+	if (l_pile) {
+		l_pile[0] = a_arbre;
+	} else {
+		l_pile_taille = 0;
+		l_valide = false;
+	}
+	while (l_pile_taille > 0) {
+		l_pile_taille = l_pile_taille - 1;
+		l_noeud = l_pile[l_pile_taille];
+		materialiser_arbre_binaire(l_noeud);
+		if (l_taille + TAILLE_ENREGISTREMENT > *a_capacite) {
+			l_nouveau = NULL;
+			if (a_extensible) {
+				l_nouvelle_capacite = *a_capacite * 2;
+				if (l_nouvelle_capacite < 64 * TAILLE_ENREGISTREMENT) {
+					l_nouvelle_capacite = 64 * TAILLE_ENREGISTREMENT;
+				}
+				l_nouveau = realloc(*a_tampon, l_nouvelle_capacite);
+			}
+			if (l_nouveau) {
+				*a_tampon = l_nouveau;
+				*a_capacite = l_nouvelle_capacite;
+			} else {
+				l_valide = false;
+			}
+		}
+		if (l_valide && l_pile_taille + 2 > l_capacite_pile) {
+			l_nouveau = realloc(l_pile,
+				l_capacite_pile * 2 * sizeof(arbre_binaire*));
+			if (l_nouveau) {
+				l_pile = l_nouveau;
+				l_capacite_pile = l_capacite_pile * 2;
+			} else {
+				l_valide = false;
+			}
+		}
+		if (l_valide) {
+			l_contenu[0] = l_noeud->valeur;
+			l_contenu[1] = l_noeud->premier_enfant != NULL;
+			l_contenu[2] = l_noeud->second_enfant != NULL;
+			memcpy(*a_tampon + l_taille, l_contenu, TAILLE_ENREGISTREMENT);
+			l_taille = l_taille + TAILLE_ENREGISTREMENT;
+			if (l_noeud->second_enfant) {
+				l_pile[l_pile_taille] = l_noeud->second_enfant;
+				l_pile_taille = l_pile_taille + 1;
+			}
+			if (l_noeud->premier_enfant) {
+				l_pile[l_pile_taille] = l_noeud->premier_enfant;
+				l_pile_taille = l_pile_taille + 1;
+			}
+		} else {
+			l_pile_taille = 0;
+		}
+	}
+	free(l_pile);
+	if (l_valide) {
+		if (TAILLE_ENTETE_ECRIT > 0) {
+			ecrire_entete_arbre_binaire(*a_tampon);
+		}
+	} else {
+		l_taille = 0;
+	}
+	return l_taille;
+}
+
+/**
+ *  \brief Renvoie le nombre d'octets ncessaires pour srialiser l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return La taille de l''arbre' srialis ou 0 si la mmoire a manqu
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+size_t taille_serialisation_arbre_binaire(arbre_binaire* a_arbre)
+{
+	size_t l_taille = 0;
+	taille_arbre_binaire l_nombre;
+	taille_arbre_binaire l_hauteur;
+	if (mesurer_arbre_binaire(a_arbre, &l_nombre, &l_hauteur)) {
+		l_taille = TAILLE_ENTETE_ECRIT +
+			(size_t)l_nombre * TAILLE_ENREGISTREMENT;
+	}
+	return l_taille;
+}
+
+/**
+ *  \brief Srialise l''arbre' dans un tampon fourni par l'appelant.
+ *
+ *  \param arbre L'arbre_binaire  srialiser
+ *  \param tampon Le tampon o crire l''arbre'
+ *  \param capacite La taille du 'tampon'
+ *
+ *  \return Le nombre d'octets crits ou 0 en cas d'erreur
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+size_t serialiser_arbre_binaire(arbre_binaire* a_arbre, void* a_tampon,
+		size_t a_capacite)
+{
+	char* l_tampon = a_tampon;
+	size_t l_capacite = a_capacite;
+	size_t l_taille;
+	a_arbre->a_erreur = false;
+	l_taille = encoder_arbre_binaire(a_arbre, &l_tampon, &l_capacite, false);
+	if (l_taille == 0) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Le tampon est trop petit pour contenir l'arbre.");
+	}
+	return l_taille;
+}
+
+/**
+ *  \brief Srialise l''arbre' dans un tampon agrandi au besoin.
+ *
+ *  \param arbre L'arbre_binaire  srialiser
+ *  \param tampon Le tampon allou avec malloc ou NULL
+ *  \param capacite La taille du 'tampon'
+ *
+ *  \return Le nombre d'octets crits ou 0 en cas d'erreur
+ *
+ *  \note 'arbre', 'tampon' et 'capacite' ne doivent pas tre NULL
+ */
+size_t serialiser_extensible_arbre_binaire(arbre_binaire* a_arbre,
+		void** a_tampon, size_t* a_capacite)
+{
+	char* l_tampon = *a_tampon;
+	size_t l_taille;
+	a_arbre->a_erreur = false;
+	l_taille = encoder_arbre_binaire(a_arbre, &l_tampon, a_capacite, true);
+	*a_tampon = l_tampon;
+	if (l_taille == 0) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire pour srialiser l'arbre.");
+	}
+	return l_taille;
+}
+
+/**
+ *  \brief Note dans 'fins' que le sous-arbre de l'enregistrement 'numero'
+ *         se termine, ainsi que ceux des enregistrements de la 'pile' dont
+ *         c'tait le dernier enfant attendu.
+ *
+ *  Tant qu'un enregistrement est dans la 'pile', 'fins' contient le nombre
+ *  de ses enfants dont le sous-arbre n'est pas termin.
+ *
+ *  \param fins Les fins des sous-arbres
+ *  \param pile Les enregistrements dont le sous-arbre n'est pas termin
+ *  \param taille Le nombre d'enregistrements dans la 'pile'
+ *  \param numero L'enregistrement sans enfant qui vient d'tre lu
+ *
+ *  \return Le nouveau nombre d'enregistrements dans la 'pile'
+ */
+size_t terminer_sous_arbres_arbre_binaire(size_t* a_fins, size_t* a_pile,
+		size_t a_taille, size_t a_numero)
+{
+	size_t l_taille = a_taille;
+	bool l_fin = false;
+	a_fins[a_numero] = a_numero + 1;
+	while (l_taille > 0 && !l_fin) {
+		a_fins[a_pile[l_taille - 1]] = a_fins[a_pile[l_taille - 1]] - 1;
+		l_fin = a_fins[a_pile[l_taille - 1]] > 0;
+		if (!l_fin) {
+			a_fins[a_pile[l_taille - 1]] = a_numero + 1;
+			l_taille = l_taille - 1;
+		}
+	}
+	return l_taille;
+}
+
+/**
+ *  \brief Vrifie qu'un tampon contient exactement un arbre srialis.
+ *
+ *  Si 'fins' n'est pas NULL, il reoit pour chaque enregistrement le numro
+ *  de l'enregistrement qui suit son sous-arbre.
+ *
+ *  \param tampon Le tampon  vrifier
+ *  \param taille La taille du 'tampon'
+ *  \param nombre Reoit le nombre de noeuds de l'arbre
+ *  \param fins Un tableau d'au moins 'taille' / TAILLE_ENREGISTREMENT
+ *              lments ou NULL
+ *
+ *  \return Le message d'erreur ou NULL si le tampon est valide
+ */
+const char* valider_tampon_arbre_binaire(const char* a_tampon,
+		size_t a_taille, size_t* a_nombre, size_t* a_fins)
+{
+	const char* l_erreur = NULL;
+	size_t l_attendus = 1;
+	size_t l_position = 0;
+	valeur_arbre_binaire l_contenu[3];
+	size_t l_capacite = 64;
+	size_t l_taille = 0;
+	size_t* l_pile = NULL;
+	void* l_nouveau;
+	*a_nombre = 0;
+	if (a_fins) {
+		l_pile = malloc(l_capacite * sizeof(size_t));
+		if (!l_pile) {
+			l_erreur = "Ne peux pas allouer la mmoire.";
+		}
+	}
+	while (l_attendus > 0 && !l_erreur) {
+		if (a_taille - l_position < TAILLE_ENREGISTREMENT) {
+			l_erreur = "L'arbre est incomplet.";
+		} else {
+			memcpy(l_contenu, a_tampon + l_position, TAILLE_ENREGISTREMENT);
+			l_position = l_position + TAILLE_ENREGISTREMENT;
+			if ((l_contenu[1] != 0 && l_contenu[1] != 1) ||
+					(l_contenu[2] != 0 && l_contenu[2] != 1)) {
+				l_erreur = "L'arbre contient un noeud invalide.";
+			} else {
+				l_attendus = l_attendus - 1 + l_contenu[1] + l_contenu[2];
+				*a_nombre = *a_nombre + 1;
+			}
+		}
+		if (!l_erreur && a_fins && l_taille == l_capacite) {
+			l_nouveau = realloc(l_pile, l_capacite * 2 * sizeof(size_t));
+			if (l_nouveau) {
+				l_pile = l_nouveau;
+				l_capacite = l_capacite * 2;
+			} else {
+				l_erreur = "Ne peux pas allouer la mmoire.";
+			}
+		}
+		if (!l_erreur && a_fins) {
+			a_fins[*a_nombre - 1] = l_contenu[1] + l_contenu[2];
+			if (a_fins[*a_nombre - 1] > 0) {
+				l_pile[l_taille] = *a_nombre - 1;
+				l_taille = l_taille + 1;
+			} else {
+				l_taille = terminer_sous_arbres_arbre_binaire(a_fins, l_pile,
+					l_taille, *a_nombre - 1);
+			}
+		}
+	}
+	if (!l_erreur && l_position != a_taille) {
+		l_erreur = "L'arbre est suivi de donnes invalides.";
+	}
+	free(l_pile);
+	return l_erreur;
+}
+
+/**
+ *  \brief Crer les 'nombre' noeuds d'un tampon valide dans un seul bloc.
+ *
+ *  Le noeud suivant dans l'ordre prfixe est plac dans le premier
+ *  emplacement attendu du noeud prcdent ou de son plus proche parent.
+ *
+ *  \param tampon Le tampon contenant l'arbre srialis
+ *  \param nombre Le nombre de noeuds dans le 'tampon'
+ *
+ *  \return La racine de l'arbre ou NULL si la mmoire a manqu
+ *
+ *  \note Le 'tampon' doit tre valid par 'valider_tampon_arbre_binaire'
+ */
+arbre_binaire* decoder_arbre_binaire(const char* a_tampon, size_t a_nombre)
+{
+	arbre_binaire* l_result = NULL;
+	bloc_arbre_binaire* l_bloc = NULL;
+	arbre_binaire l_attendu;
+	arbre_binaire* l_noeud;
+	arbre_binaire* l_parent = NULL;
+	valeur_arbre_binaire l_contenu[3];
+	size_t l_i;
+	if (a_nombre <= (SIZE_MAX - sizeof(bloc_arbre_binaire)) /
+			sizeof(arbre_binaire)) {
+		l_bloc = malloc(sizeof(bloc_arbre_binaire) +
+			a_nombre * sizeof(arbre_binaire));
+	}
+	if (l_bloc) {
+		atomic_init(&l_bloc->vivants, a_nombre);
+		l_bloc->differe = NULL;
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			l_noeud = &l_bloc->noeuds[l_i];
+			memcpy(l_contenu, a_tampon + l_i * TAILLE_ENREGISTREMENT,
+				TAILLE_ENREGISTREMENT);
+			initialiser_arbre_binaire(l_noeud, l_contenu[0], l_bloc);
+			if (l_contenu[1]) {
+				l_noeud->premier_enfant = &l_attendu;
+			}
+			if (l_contenu[2]) {
+				l_noeud->second_enfant = &l_attendu;
+			}
+			while (l_parent && l_parent->premier_enfant != &l_attendu &&
+					l_parent->second_enfant != &l_attendu) {
+				l_parent = l_parent->parent;
+			}
+			if (l_parent) {
+				if (l_parent->premier_enfant == &l_attendu) {
+					l_parent->premier_enfant = l_noeud;
+				} else {
+					l_parent->second_enfant = l_noeud;
+				}
+				l_noeud->parent = l_parent;
+			}
+			l_parent = l_noeud;
+		}
+		l_result = &l_bloc->noeuds[0];
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Crer un nouvel arbre_binaire depuis un tampon.
+ *
+ *  \param tampon Le tampon contenant l'arbre srialis
+ *  \param taille La taille du 'tampon'
+ *
+ *  \return L'arbre_binaire
+ */
+arbre_binaire* deserialiser_arbre_binaire(const void* a_tampon,
+		size_t a_taille)
+{
+	arbre_binaire* l_result = NULL;
+	const char* l_enregistrements = a_tampon;
+	char* l_converti = NULL;
+	size_t l_debut;
+	size_t l_taille;
+	size_t l_nombre;
+	const char* l_erreur = lire_entete_arbre_binaire(a_tampon, a_taille,
+		&l_debut);
+	l_enregistrements = l_enregistrements + l_debut;
+	l_taille = a_taille - l_debut;
+#ifdef ARBRE_BINAIRE_64
+	if (!l_erreur && l_debut == 0) {
+		l_converti = convertir_version_1_arbre_binaire(l_enregistrements,
+			l_taille, &l_taille);
+		l_enregistrements = l_converti;
+		if (!l_converti) {
+			l_erreur = "Ne peux pas allouer la mmoire.";
+		}
+	}
+#endif
+	if (!l_erreur) {
+		l_erreur = valider_tampon_arbre_binaire(l_enregistrements, l_taille,
+			&l_nombre, NULL);
+	}
+	if (!l_erreur) {
+		l_result = decoder_arbre_binaire(l_enregistrements, l_nombre);
+		if (!l_result) {
+			l_erreur = "Ne peux pas allouer la mmoire.";
+		}
+	}
+	free(l_converti);
+	if (l_erreur) {
+		l_result = creer_arbre_binaire(0);
+		if (l_result) {
+			inscrire_erreur_arbre_binaire(l_result, l_erreur);
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Crer un nouvel arbre_binaire depuis un fichier en ne chargeant
+ *         que les premiers niveaux.
+ *
+ *  Les sous-arbres plus profonds sont lus dans le fichier, 'profondeur'
+ *  niveaux  la fois, lorsque leurs noeuds sont utiliss. Si 'budget' n'est
+ *  pas 0, les morceaux non modifis et non pingls les moins rcemment
+ *  utiliss sont dsallous lorsque plus de 'budget' noeuds ont t
+ *  matrialiss. Le fichier est lu une fois  l'ouverture pour tre valid
+ *  et pour noter o se termine chaque sous-arbre, ce qui permet ensuite de
+ *  ne lire que les enregistrements des morceaux matrialiss.
+ *  Dans la variante ARBRE_BINAIRE_64, un fichier de la version 1 du format
+ *  est charg en entier par charger_arbre_binaire.
+ *
+ *  \param nom_fichier Le nom du fichier contenant l'arbre
+ *  \param profondeur Le nombre de niveaux matrialiss  la fois
+ *  \param budget Le nombre maximal de noeuds matrialiss ou 0
+ *
+ *  \return L'arbre_binaire
+ *
+ *  \note Le fichier doit tre cr  l'aide de la routine
+ *  sauvegarder_arbre_binaire et ne doit pas tre modifi tant que l'arbre
+ *  existe.
+ */
+arbre_binaire* charger_paresseux_arbre_binaire(char* a_nom_fichier,
+		int a_profondeur, size_t a_budget)
+{
+	arbre_binaire* l_result = NULL;
+	int l_fichier = open(a_nom_fichier, O_RDONLY);
+	struct stat l_etat;
+	char* l_contenu = MAP_FAILED;
+	source_arbre_binaire* l_source = NULL;
+	pthread_mutexattr_t l_attributs;
+	const char* l_erreur = NULL;
+	size_t l_debut = 0;
+	size_t l_nombre;
+	size_t* l_fins = NULL;
+	valeur_arbre_binaire l_racine[3];
+	if (l_fichier >= 0 && fstat(l_fichier, &l_etat) == 0 &&
+			l_etat.st_size > 0) {
+		l_contenu = mmap(NULL, l_etat.st_size, PROT_READ, MAP_PRIVATE,
+			l_fichier, 0);
+	}
+	if (l_fichier >= 0) {
+		close(l_fichier);
+	}
+	if (l_contenu != MAP_FAILED) {
+		l_erreur = lire_entete_arbre_binaire(l_contenu, l_etat.st_size,
+			&l_debut);
+#ifdef ARBRE_BINAIRE_64
+		if (!l_erreur && l_debut == 0) {
+			munmap(l_contenu, l_etat.st_size);
+			l_contenu = MAP_FAILED;
+		}
+#endif
+	}
+	if (l_contenu == MAP_FAILED) {
+		l_result = charger_arbre_binaire(a_nom_fichier);
+	} else {
+		madvise(l_contenu, l_etat.st_size, MADV_SEQUENTIAL);
+		if (!l_erreur) {
+			l_fins = malloc((l_etat.st_size / TAILLE_ENREGISTREMENT + 1) *
+				sizeof(size_t));
+		}
+		if (l_fins) {
+			l_erreur = valider_tampon_arbre_binaire(l_contenu + l_debut,
+				l_etat.st_size - l_debut, &l_nombre, l_fins);
+		}
+		madvise(l_contenu, l_etat.st_size, MADV_DONTNEED);
+		madvise(l_contenu, l_etat.st_size, MADV_RANDOM);
+		if (l_fins && !l_erreur) {
+			l_source = calloc(1, sizeof(source_arbre_binaire));
+			memcpy(l_racine, l_contenu + l_debut, TAILLE_ENREGISTREMENT);
+			l_result = creer_arbre_binaire(l_racine[0]);
+		}
+		if (l_source && l_result) {
+			l_source->contenu = l_contenu + l_debut;
+			l_source->taille = l_etat.st_size - l_debut;
+			l_source->entete = l_debut;
+			l_source->fins = l_fins;
+			l_source->profondeur = a_profondeur;
+			if (l_source->profondeur < 1) {
+				l_source->profondeur = 1;
+			}
+			if ((size_t)l_source->profondeur > l_nombre) {
+				l_source->profondeur = l_nombre;
+			}
+			l_source->budget = a_budget;
+			l_source->attentes = malloc(l_source->profondeur * sizeof(int));
+			l_result->differe = creer_differe_arbre_binaire(l_source, NULL);
+		}
+		if (l_result && l_result->differe && l_source->attentes) {
+			pthread_mutexattr_init(&l_attributs);
+			pthread_mutexattr_settype(&l_attributs,
+				PTHREAD_MUTEX_RECURSIVE);
+			pthread_mutex_init(&l_source->verrou, &l_attributs);
+			pthread_mutexattr_destroy(&l_attributs);
+			l_result->differe->noeud = l_result;
+			l_result->paresseux = true;
+			materialiser_arbre_binaire(l_result);
+		} else {
+			if (l_result) {
+				free(l_result->differe);
+				l_result->differe = NULL;
+				detruire_arbre_binaire(l_result);
+				l_result = NULL;
+			}
+			if (l_source) {
+				free(l_source->attentes);
+				free(l_source);
+			}
+			free(l_fins);
+			munmap(l_contenu, l_etat.st_size);
+			if (!l_erreur) {
+				l_erreur = "Ne peux pas allouer la mmoire.";
+			}
+			l_result = creer_arbre_binaire(0);
+			if (l_result) {
+				inscrire_erreur_arbre_binaire(l_result, l_erreur);
+			}
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Relche un noeud obtenu par 'premier_enfant_epingle_arbre_binaire'
+ *         ou 'second_enfant_epingle_arbre_binaire' afin que le morceau
+ *         charg paresseusement qui le contient puisse de nouveau tre
+ *         vinc.
+ *
+ *  \param arbre L'arbre_binaire  relcher
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void relacher_arbre_binaire(arbre_binaire* a_arbre)
+{
+	differe_arbre_binaire* l_differe = NULL;
+	source_arbre_binaire* l_source;
+	if (a_arbre->bloc) {
+		l_differe = a_arbre->bloc->differe;
+	}
+	if (l_differe) {
+		l_source = l_differe->source;
+		pthread_mutex_lock(&l_source->verrou);
+		if (l_differe->epingles > 0) {
+			l_differe->epingles = l_differe->epingles - 1;
+		}
+		if (evincable_differe_arbre_binaire(l_differe)) {
+			toucher_differe_arbre_binaire(l_differe);
+		}
+		evincer_arbre_binaire(l_source);
+		pthread_mutex_unlock(&l_source->verrou);
+	}
+}
+
+/**
+ *  \brief Sauvegarder l'arbre_binaire dans un fichier
+ *
+ *  Sauvegarde le contenue de l''arbre' dans le fichier 'nom_fichier'.
+ *  Si le fichier n'est pas valide, indique l'erreur dans 'arbre'->'erreur'.
+ *
+ *  \param arbre L'arbre_binaire
+ *  \param nom_fichier Le nom du fichier  sauvegarder l'arbre
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void sauvegarder_arbre_binaire(arbre_binaire* a_arbre, char* a_nom_fichier)
+{
+	FILE* l_fichier;
+	void* l_tampon = NULL;
+	size_t l_capacite = 0;
+	size_t l_taille;
+	a_arbre->a_erreur = false;
+	l_fichier = fopen(a_nom_fichier, "wb");
+	if (l_fichier) {
+		l_taille = serialiser_extensible_arbre_binaire(a_arbre, &l_tampon,
+			&l_capacite);
+		if (l_taille > 0 && fwrite(l_tampon, 1, l_taille, l_fichier) !=
+				l_taille) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Ne peux pas crire dans le fichier.");
+		}
+		free(l_tampon);
+		fclose(l_fichier);
+	} else {
+		inscrire_erreur_arbre_binaire(a_arbre, 
+			"Ne peux pas ouvrir le fichier en criture.");
+	}
+}
+ 
+/**
+ *  \brief Renvoie le nombre d'lments de l''arbre'
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return Le nombre d'lments dans l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+taille_arbre_binaire nombre_elements_arbre_binaire(arbre_binaire* a_arbre)
+{
+	taille_arbre_binaire l_nombre_elements = 1;
+	materialiser_arbre_binaire(a_arbre);
+	if (a_arbre->premier_enfant) {
+		l_nombre_elements = l_nombre_elements + 
+			nombre_elements_arbre_binaire(a_arbre->premier_enfant);
+	}
+	if (a_arbre->second_enfant) {
+		l_nombre_elements = l_nombre_elements + 
+			nombre_elements_arbre_binaire(a_arbre->second_enfant);
+	}
+	return l_nombre_elements;
+}
+
+/**
+ *  \brief Renvoie le nombre de feuilles de l''arbre'
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return Le nombre de feuilles dans l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+taille_arbre_binaire nombre_feuilles_arbre_binaire(arbre_binaire* a_arbre)
+{
+	taille_arbre_binaire l_nombre_feuilles = 0;
+	materialiser_arbre_binaire(a_arbre);
+	if (!a_arbre->premier_enfant && !a_arbre->second_enfant) {
+		l_nombre_feuilles = 1;
+	} else {
+		if (a_arbre->premier_enfant) {
+			l_nombre_feuilles = l_nombre_feuilles + 
+				nombre_feuilles_arbre_binaire(a_arbre->premier_enfant);
+		}
+		if (a_arbre->second_enfant) {
+			l_nombre_feuilles = l_nombre_feuilles + 
+				nombre_feuilles_arbre_binaire(a_arbre->second_enfant);
+		}
+	}
+	return l_nombre_feuilles;
+}
+
+/**
+ *  \brief Renvoie la hauteur de l''arbre'
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return La hauteur de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+taille_arbre_binaire hauteur_arbre_binaire(arbre_binaire* a_arbre)
+{
+	taille_arbre_binaire l_hauteur = 1;
+	materialiser_arbre_binaire(a_arbre);
+	if (a_arbre->premier_enfant || a_arbre->second_enfant) {
+		taille_arbre_binaire l_hauteur_premier_enfant;
+		taille_arbre_binaire l_hauteur_second_enfant;
+		if (a_arbre->premier_enfant) {
+			l_hauteur_premier_enfant = 
+				hauteur_arbre_binaire(a_arbre->premier_enfant);
+		} else {
+			l_hauteur_premier_enfant = 0;
+		}
+		if (a_arbre->second_enfant) {
+			l_hauteur_second_enfant = 
+				hauteur_arbre_binaire(a_arbre->second_enfant);
+		} else {
+			l_hauteur_second_enfant = 0;
+		}
+		if (l_hauteur_premier_enfant >= l_hauteur_second_enfant) {
+			l_hauteur = l_hauteur + l_hauteur_premier_enfant;
+		} else {
+			l_hauteur = l_hauteur + l_hauteur_second_enfant;
+		}
+	}
+	return l_hauteur;
+}
+
+/**
+ *  \brief Renvoie l'lment contenu dans la racine de l''arbre'
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return La valeur de l'lment contenu dans la racine de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+valeur_arbre_binaire element_arbre_binaire(arbre_binaire* a_arbre)
+{
+	return a_arbre->valeur;
+}
+
+/**
+ *  \brief Modifie l'lment contenu dans la racine de l''arbre'
+ *
+ *  \param arbre L'arbre_binaire
+ *  \param valeur La valeur  mettre dans la racine de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void modifier_element_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_valeur)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		a_arbre->valeur = a_valeur;
+		invalider_hachage_arbre_binaire(a_arbre);
+	}
+}
+
+/**
+ *  \brief Regarde dans l''arbre' s'il contient la 'valeur'.
+ *
+ *  \param arbre L'arbre_binaire  rechercher la valeur
+ *  \param valeur La valeur  rechercher dans l''arbre'
+ *
+ *  \return true si la valeur existe dans l''arbre', false sinon.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool contient_element_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_valeur)
+{
+	bool l_contient = false;
+	materialiser_arbre_binaire(a_arbre);
+	if (a_arbre->valeur == a_valeur) {
+		l_contient = true;
+	} else {
+		if (a_arbre->premier_enfant) {
+			if (contient_element_arbre_binaire(a_arbre->premier_enfant,
+			a_valeur)) {
+				l_contient = true;
+			}
+		}
+		if (a_arbre->second_enfant) {
+			if (contient_element_arbre_binaire(a_arbre->second_enfant,
+			a_valeur)) {
+				l_contient = true;
+			}
+		}
+	}
+	return l_contient;
+}
+
+/**
+ *  \brief Retourne une version non partage de l''enfant' de l''arbre'.
+ *
+ *  Si l''enfant' a d'autres rfrences, une copie de sa racine est cre et
+ *  partage  son tour les enfants de l''enfant'. Si l''arbre' en est le seul
+ *  propritaire, l''enfant' cesse simplement d'tre partag.
+ *
+ *  \param arbre Le parent de l''enfant' ou NULL
+ *  \param enfant L'enfant  rendre unique
+ *
+ *  \return L'enfant non partag  placer dans l''arbre' ou l''enfant'
+ *           toujours partag si la mmoire a manqu
+ *
+ *  \note 'enfant' ne doit pas tre NULL et l''arbre' ne doit pas tre
+ *  partag
+ */
+arbre_binaire* enfant_unique_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_enfant)
+{
+	arbre_binaire* l_result = a_enfant;
+	if (a_enfant->partage && atomic_load(&a_enfant->references) > 1) {
+		materialiser_arbre_binaire(a_enfant);
+		l_result = creer_arbre_binaire(a_enfant->valeur);
+		if (l_result) {
+			l_result->premier_enfant = a_enfant->premier_enfant;
+			if (l_result->premier_enfant) {
+				ajouter_reference_arbre_binaire(l_result->premier_enfant);
+			}
+			l_result->second_enfant = a_enfant->second_enfant;
+			if (l_result->second_enfant) {
+				ajouter_reference_arbre_binaire(l_result->second_enfant);
+			}
+			l_result->hachage = a_enfant->hachage;
+			l_result->hachage_valide = a_enfant->hachage_valide;
+			detruire_arbre_binaire(a_enfant);
+		} else {
+			l_result = a_enfant;
+		}
+	} else {
+		l_result->partage = false;
+	}
+	if (!l_result->partage) {
+		l_result->parent = a_arbre;
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Retire l'erreur de l''arbre' si l''enfant' existe ou l'indique
+ *         dans l''arbre' sinon.
+ *
+ *  Seule l'erreur de l''arbre' est retire. Celles de ses descendants sont
+ *  conserves, ce qui vite de parcourir le sous-arbre  chaque accs.
+ *
+ *  \param arbre L'arbre_binaire dont l'enfant a t demand
+ *  \param enfant L'enfant trouv ou NULL
+ *  \param erreur Le texte de l'erreur si l''enfant' est NULL
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void signaler_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_enfant, const char* a_erreur)
+{
+	if (a_enfant) {
+		a_arbre->a_erreur = false;
+	} else {
+		inscrire_erreur_arbre_binaire(a_arbre, a_erreur);
+	}
+}
+
+/**
+ *  \brief Retourne l'enfant plac dans l'emplacement 'enfant' de l''arbre'
+ *         aprs l'avoir rendu unique afin qu'il puisse tre modifi.
+ *
+ *  \param arbre L'arbre_binaire qui contient l'enfant
+ *  \param enfant L'emplacement de l'enfant dans l''arbre'
+ *  \param erreur Le texte de l'erreur si l'emplacement est vide
+ *
+ *  \return L'enfant modifiable ou NULL en cas d'erreur
+ *
+ *  \note 'arbre' et 'enfant' ne doivent pas tre NULL
+ */
+arbre_binaire* enfant_modifiable_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire** a_enfant, const char* a_erreur)
+{
+	arbre_binaire* l_result = NULL;
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		utiliser_arbre_binaire(a_arbre);
+		signaler_enfant_arbre_binaire(a_arbre, *a_enfant, a_erreur);
+		if (*a_enfant) {
+			*a_enfant = enfant_unique_arbre_binaire(a_arbre, *a_enfant);
+			if ((*a_enfant)->partage) {
+				inscrire_erreur_arbre_binaire(a_arbre,
+					"Ne peux pas allouer la mmoire.");
+			} else {
+				l_result = *a_enfant;
+				if (a_arbre->paresseux) {
+					marquer_modifie_arbre_binaire(a_arbre);
+				}
+			}
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Retourne le premier enfant de l''arbre' ou 'NULL' si l''arbre' n'a
+ *         pas de premier enfant.
+ *
+ *  \param arbre L'arbre_binaire  regarder son premier enfant.
+ *
+ *  \return le premier enfant de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_premier_enfant;
+	utiliser_arbre_binaire(a_arbre);
+	l_premier_enfant = a_arbre->premier_enfant;
+	signaler_enfant_arbre_binaire(a_arbre, l_premier_enfant,
+		"L'arbre n'a aucun premier enfant.");
+	return l_premier_enfant;
+}
+
+/**
+ *  \brief Retourne le premier enfant de l''arbre' en pinglant le morceau
+ *         charg paresseusement qui le contient.
+ *
+ *  \param arbre L'arbre_binaire  regarder son premier enfant.
+ *
+ *  \return le premier enfant de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* premier_enfant_epingle_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_premier_enfant = enfant_epingle_arbre_binaire(a_arbre,
+		&a_arbre->premier_enfant);
+	signaler_enfant_arbre_binaire(a_arbre, l_premier_enfant,
+		"L'arbre n'a aucun premier enfant.");
+	return l_premier_enfant;
+}
+
+/**
+ *  \brief Retourne le premier enfant de l''arbre' aprs l'avoir copi s'il
+ *         est partag.
+ *
+ *  \param arbre L'arbre_binaire  regarder son premier enfant.
+ *
+ *  \return le premier enfant de l''arbre' ou NULL en cas d'erreur
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* premier_enfant_modifiable_arbre_binaire(arbre_binaire* a_arbre)
+{
+	return enfant_modifiable_arbre_binaire(a_arbre, &a_arbre->premier_enfant,
+		"L'arbre n'a aucun premier enfant.");
+}
+
+/**
+ *  \brief Ajoute un premier enfant d'un 'arbre' et place la valeur dans la
+ *         racine de cet enfant.
+ *
+ *  \param arbre L'arbre_binaire  ajouter un premier enfant
+ *  \param valeur La valeur  mettre dans la racine du premier enfant
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void creer_premier_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_valeur)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (!a_arbre->premier_enfant) {
+			arbre_binaire* l_premier_enfant = creer_arbre_binaire(a_valeur);
+			l_premier_enfant->parent = a_arbre;
+			a_arbre->premier_enfant = l_premier_enfant;
+			invalider_hachage_arbre_binaire(a_arbre);
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Premier enfant dja existant.");
+		}
+	}
+}
+
+/**
+ *  \brief Libre le premier enfant d'un 'arbre'.
+ *
+ *  \param arbre L'arbre_binaire  retirer le premier enfant
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void retirer_premier_enfant_arbre_binaire(arbre_binaire* a_arbre)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (a_arbre->premier_enfant) {
+			detruire_arbre_binaire(a_arbre->premier_enfant);
+			a_arbre->premier_enfant = NULL;
+			invalider_hachage_arbre_binaire(a_arbre);
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Aucun premier enfant  enlever.");
+		}
+	}
+}
+
+/**
+ *  \brief Retourne le second enfant de l''arbre' ou 'NULL' si l''arbre' n'a
+ *         pas de second enfant.
+ *
+ *  \param arbre L'arbre_binaire  regarder son second enfant.
+ *
+ *  \return le second enfant de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_second_enfant;
+	utiliser_arbre_binaire(a_arbre);
+	l_second_enfant = a_arbre->second_enfant;
+	signaler_enfant_arbre_binaire(a_arbre, l_second_enfant,
+		"L'arbre n'a aucun second enfant.");
+	return l_second_enfant;
+}
+
+/**
+ *  \brief Retourne le second enfant de l''arbre' en pinglant le morceau
+ *         charg paresseusement qui le contient.
+ *
+ *  \param arbre L'arbre_binaire  regarder son second enfant.
+ *
+ *  \return le second enfant de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* second_enfant_epingle_arbre_binaire(arbre_binaire* a_arbre)
+{
+	arbre_binaire* l_second_enfant = enfant_epingle_arbre_binaire(a_arbre,
+		&a_arbre->second_enfant);
+	signaler_enfant_arbre_binaire(a_arbre, l_second_enfant,
+		"L'arbre n'a aucun second enfant.");
+	return l_second_enfant;
+}
+
+/**
+ *  \brief Retourne le second enfant de l''arbre' aprs l'avoir copi s'il
+ *         est partag.
+ *
+ *  \param arbre L'arbre_binaire  regarder son second enfant.
+ *
+ *  \return le second enfant de l''arbre' ou NULL en cas d'erreur
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* second_enfant_modifiable_arbre_binaire(arbre_binaire* a_arbre)
+{
+	return enfant_modifiable_arbre_binaire(a_arbre, &a_arbre->second_enfant,
+		"L'arbre n'a aucun second enfant.");
+}
+
+/**
+ *  \brief Ajoute un second enfant d'un 'arbre' et place la valeur dans la
+ *         racine de cet enfant.
+ *
+ *  \param arbre L'arbre_binaire  ajouter un second enfant
+ *  \param valeur La valeur  mettre dans la racine du second enfant
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void creer_second_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_valeur)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (!a_arbre->second_enfant) {
+			arbre_binaire* l_second_enfant = creer_arbre_binaire(a_valeur);
+			l_second_enfant->parent = a_arbre;
+			a_arbre->second_enfant = l_second_enfant;
+			invalider_hachage_arbre_binaire(a_arbre);
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Second enfant dja existant.");
+		}
+	}
+}
+
+/**
+ *  \brief Libre le premier enfant d'un 'arbre'.
+ *
+ *  \param arbre L'arbre_binaire  retirer le premier enfant
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void retirer_second_enfant_arbre_binaire(arbre_binaire* a_arbre)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (a_arbre->second_enfant) {
+			detruire_arbre_binaire(a_arbre->second_enfant);
+			a_arbre->second_enfant = NULL;
+			invalider_hachage_arbre_binaire(a_arbre);
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Aucun second enfant  enlever.");
+		}
+	}
+}
+
+/**
+ *  \brief Indique si l''arbre' contient une erreur
+ *
+ *  \return true si l''arbre' contient une erreur, false sinon.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool a_erreur_arbre_binaire(arbre_binaire* a_arbre)
+{
+	bool l_erreur = a_arbre->a_erreur;
+	if (!l_erreur) {
+		if (a_arbre->premier_enfant) {
+			if (a_erreur_arbre_binaire(a_arbre->premier_enfant)) {
+				l_erreur = true;
+			}
+		}
+		if (!l_erreur) {
+			if (a_arbre->second_enfant) {
+				if (a_erreur_arbre_binaire(a_arbre->second_enfant)) {
+					l_erreur = true;
+				}
+			}
+		}
+	}
+	return l_erreur;
+}
+
+/**
+ *  \brief Retourne le tampon de l'erreur de l''arbre'.
+ *
+ *  Le tampon n'est allou que lorsqu'il est utilis pour la premire fois.
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return Le tampon ou NULL si l'allocation a chou
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+char* tampon_erreur_arbre_binaire(arbre_binaire* a_arbre)
+{
+	if (!a_arbre->erreur) {
+		a_arbre->erreur = calloc(ERREUR_TAILLE, sizeof(char));
+	}
+	return a_arbre->erreur;
+}
+
+/**
+ *  \brief Indique le texte de l'erreur contenue dans 'arbre'
+ *
+ *  Si 'a_erreur_arbre_binaire' indique que l''arbre' contient une erreur,
+ *  retourne l'erreur qu'il contient. Si 'a_erreur_arbre_binaire' est Faux,
+ *  Retourne une chaine vide.
+ *
+ *  \return Le texte de l'erreur.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+char* erreur_arbre_binaire(arbre_binaire* a_arbre)
+{
+	char* l_erreur = NULL;
+	if (!a_erreur_arbre_binaire(a_arbre)) {
+		l_erreur = tampon_erreur_arbre_binaire(a_arbre);
+		if (l_erreur) {
+			strncpy(l_erreur, "", ERREUR_TAILLE);
+		}
+    } else {
+		if (!a_arbre->a_erreur) {
+			if (a_arbre->premier_enfant) {
+				if (a_erreur_arbre_binaire(a_arbre->premier_enfant)) {
+					l_erreur = erreur_arbre_binaire(a_arbre->premier_enfant);
+				}
+			}
+			if (a_arbre->second_enfant) {
+				if (a_erreur_arbre_binaire(a_arbre->premier_enfant)) {
+					l_erreur = erreur_arbre_binaire(a_arbre->second_enfant);
+				}
+			}
+		} else {
+			l_erreur = a_arbre->erreur;
+		}
+	}
+    return l_erreur;
+}
+
+/**
+ *  \brief Inscrit l'erreur dans l''arbre'
+ *
+ *  \param erreur Le texte de l'erreur.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void inscrire_erreur_arbre_binaire(arbre_binaire* a_arbre, const char* a_erreur)
+{
+	char* l_tampon = tampon_erreur_arbre_binaire(a_arbre);
+	a_arbre->a_erreur = true;
+	if (l_tampon) {
+		strncpy(l_tampon, a_erreur, ERREUR_TAILLE);
+	}
+}
+
+/**
+ *  \brief Retire tout erreur dans l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+void retirer_erreur_arbre_binaire(arbre_binaire* a_arbre)
+{
+	a_arbre->a_erreur = false;
+	if (a_arbre->premier_enfant) {
+		retirer_erreur_arbre_binaire(a_arbre->premier_enfant);
+	}
+	if (a_arbre->second_enfant) {
+		retirer_erreur_arbre_binaire(a_arbre->second_enfant);
+	}
+}
+
+/**
+ *  \brief Mlange les bits d'une valeur de 64 bits.
+ *
+ *  \param valeur La valeur  mlanger
+ *
+ *  \return La valeur mlange
+ */
+uint64_t melanger_hachage_arbre_binaire(uint64_t a_valeur)
+{
+	uint64_t l_result = a_valeur;
+	l_result = (l_result ^ (l_result >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	l_result = (l_result ^ (l_result >> 27)) * 0x94D049BB133111EBULL;
+	l_result = l_result ^ (l_result >> 31);
+	return l_result;
+}
+
+/**
+ *  \brief Calcule et conserve le hachage d'un noeud  partir des hachages
+ *         de ses enfants.
+ *
+ *  \param arbre Le noeud  hacher
+ *  \param hachage_premier_enfant Le hachage du premier enfant ou
+ *                                HACHAGE_ABSENT
+ *  \param hachage_second_enfant Le hachage du second enfant ou
+ *                               HACHAGE_ABSENT
+ *
+ *  \return Le hachage de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+uint64_t hacher_noeud_arbre_binaire(arbre_binaire* a_arbre,
+		uint64_t a_hachage_premier_enfant, uint64_t a_hachage_second_enfant)
+{
+	a_arbre->hachage = melanger_hachage_arbre_binaire(
+		(uint64_t)a_arbre->valeur);
+	a_arbre->hachage = melanger_hachage_arbre_binaire(
+		a_arbre->hachage ^ a_hachage_premier_enfant);
+	a_arbre->hachage = melanger_hachage_arbre_binaire(
+		(a_arbre->hachage + HACHAGE_ABSENT) ^ a_hachage_second_enfant);
+	a_arbre->hachage_valide = true;
+	return a_arbre->hachage;
+}
+
+/**
+ *  \brief Renvoie le hachage de la structure et des valeurs de l''arbre'
+ *
+ *  Les noeuds dont le hachage doit tre calcul sont parcourus en ordre
+ *  postfixe  l'aide d'une pile. Les enfants empils sont pingls afin
+ *  qu'un arbre charg paresseusement ne les vince pas avant leur parent.
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return Le hachage de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+uint64_t hachage_arbre_binaire(arbre_binaire* a_arbre)
+{
+	uint64_t l_hachage = a_arbre->hachage;
+	size_t l_capacite = 64;
+	size_t l_taille = 0;
+	parcours_hachage_arbre_binaire* l_pile = NULL;
+	parcours_hachage_arbre_binaire* l_cadre;
+	arbre_binaire* l_enfant;
+	void* l_nouveau;
+	if (!a_arbre->hachage_valide) {
+		l_pile = malloc(l_capacite * sizeof(parcours_hachage_arbre_binaire));
+		if (l_pile) {
+			l_pile[0].noeud = a_arbre;
+			l_pile[0].etape = 0;
+			l_taille = 1;
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Ne peux pas allouer la mmoire pour calculer le hachage.");
+		}
+	}
+	while (l_taille > 0) {
+		l_cadre = &l_pile[l_taille - 1];
+		l_enfant = NULL;
+		if (l_cadre->etape == 0 && l_cadre->noeud->hachage_valide) {
+			l_hachage = l_cadre->noeud->hachage;
+			l_cadre->etape = 3;
+		} else if (l_cadre->etape == 0) {
+			l_hachage = HACHAGE_ABSENT;
+			l_enfant = enfant_epingle_arbre_binaire(l_cadre->noeud,
+				&l_cadre->noeud->premier_enfant);
+			l_cadre->etape = 1;
+		} else if (l_cadre->etape == 1) {
+			l_cadre->hachage_premier_enfant = l_hachage;
+			l_hachage = HACHAGE_ABSENT;
+			l_enfant = enfant_epingle_arbre_binaire(l_cadre->noeud,
+				&l_cadre->noeud->second_enfant);
+			l_cadre->etape = 2;
+		} else {
+			l_hachage = hacher_noeud_arbre_binaire(l_cadre->noeud,
+				l_cadre->hachage_premier_enfant, l_hachage);
+			l_cadre->etape = 3;
+		}
+		if (l_cadre->etape == 3) {
+			if (l_taille > 1) {
+				relacher_arbre_binaire(l_cadre->noeud);
+			}
+			l_taille = l_taille - 1;
+		} else if (l_enfant) {
+			if (l_taille == l_capacite) {
+				l_nouveau = realloc(l_pile, l_capacite * 2 *
+					sizeof(parcours_hachage_arbre_binaire));
+				if (l_nouveau) {
+					l_pile = l_nouveau;
+					l_capacite = l_capacite * 2;
+				} else {
+					relacher_arbre_binaire(l_enfant);
+					while (l_taille > 1) {
+						l_taille = l_taille - 1;
+						relacher_arbre_binaire(l_pile[l_taille].noeud);
+					}
+					l_taille = 0;
+					l_enfant = NULL;
+					inscrire_erreur_arbre_binaire(a_arbre,
+						"Ne peux pas allouer la mmoire pour calculer le "
+						"hachage.");
+				}
+			}
+			if (l_enfant) {
+				l_pile[l_taille].noeud = l_enfant;
+				l_pile[l_taille].etape = 0;
+				l_taille = l_taille + 1;
+			}
+		}
+	}
+	free(l_pile);
+	return l_hachage;
+}
+
+/**
+ *  \brief Ajoute  la 'pile' la paire forme par les enfants placs dans
+ *         les emplacements 'enfant1' et 'enfant2'.
+ *
+ *  Les enfants sont pingls et doivent tre relchs par l'appelant.
+ *
+ *  \param pile La pile de paires de noeuds, o il reste une place
+ *  \param taille Le nombre de paires dans la 'pile'
+ *  \param arbre1 Le noeud qui contient 'enfant1'
+ *  \param enfant1 L'emplacement d'un enfant de 'arbre1'
+ *  \param arbre2 Le noeud qui contient 'enfant2'
+ *  \param enfant2 L'emplacement d'un enfant de 'arbre2'
+ *
+ *  \return false si un seul des deux enfants existe, true sinon.
+ */
+bool empiler_enfants_arbre_binaire(arbre_binaire** a_pile, size_t* a_taille,
+		arbre_binaire* a_arbre1, arbre_binaire** a_enfant1,
+		arbre_binaire* a_arbre2, arbre_binaire** a_enfant2)
+{
+	bool l_result = true;
+	arbre_binaire* l_enfant1 = enfant_epingle_arbre_binaire(a_arbre1,
+		a_enfant1);
+	arbre_binaire* l_enfant2 = enfant_epingle_arbre_binaire(a_arbre2,
+		a_enfant2);
+	if (l_enfant1 && l_enfant2) {
+		a_pile[*a_taille * 2] = l_enfant1;
+		a_pile[*a_taille * 2 + 1] = l_enfant2;
+		*a_taille = *a_taille + 1;
+	} else if (l_enfant1) {
+		relacher_arbre_binaire(l_enfant1);
+		l_result = false;
+	} else if (l_enfant2) {
+		relacher_arbre_binaire(l_enfant2);
+		l_result = false;
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Compare noeud par noeud deux arbres dont les hachages sont gaux.
+ *
+ *  Les sous-arbres qui sont le mme noeud ne sont pas parcourus et ceux dont
+ *  les hachages dj calculs diffrent sont rejets sans tre parcourus.
+ *
+ *  \param arbre1 Le premier arbre_binaire  comparer
+ *  \param arbre2 Le second arbre_binaire  comparer
+ *
+ *  \return true si les deux arbres sont identiques, false sinon ou si la
+ *          mmoire a manqu.
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas tre NULL
+ */
+bool structures_identiques_arbre_binaire(arbre_binaire* a_arbre1,
+		arbre_binaire* a_arbre2)
+{
+	bool l_egal = true;
+	bool l_racine = true;
+	size_t l_capacite = 64;
+	size_t l_taille = 1;
+	arbre_binaire** l_pile = malloc(l_capacite * 2 * sizeof(arbre_binaire*));
+	arbre_binaire* l_noeud1;
+	arbre_binaire* l_noeud2;
+	void* l_nouveau;
+	if (l_pile) {
+		l_pile[0] = a_arbre1;
+		l_pile[1] = a_arbre2;
+	} else {
+		l_taille = 0;
+		l_egal = false;
+		inscrire_erreur_arbre_binaire(a_arbre1,
+			"Ne peux pas allouer la mmoire pour comparer les arbres.");
+	}
+	while (l_taille > 0) {
+		l_taille = l_taille - 1;
+		l_noeud1 = l_pile[l_taille * 2];
+		l_noeud2 = l_pile[l_taille * 2 + 1];
+		if (l_egal && l_noeud1 != l_noeud2) {
+			if (l_noeud1->valeur != l_noeud2->valeur ||
+					(l_noeud1->hachage_valide && l_noeud2->hachage_valide &&
+					l_noeud1->hachage != l_noeud2->hachage)) {
+				l_egal = false;
+			}
+			if (l_egal && l_taille + 2 > l_capacite) {
+				l_nouveau = realloc(l_pile,
+					l_capacite * 4 * sizeof(arbre_binaire*));
+				if (l_nouveau) {
+					l_pile = l_nouveau;
+					l_capacite = l_capacite * 2;
+				} else {
+					l_egal = false;
+					inscrire_erreur_arbre_binaire(a_arbre1,
+						"Ne peux pas allouer la mmoire pour comparer les "
+						"arbres.");
+				}
+			}
+			if (l_egal) {
+				l_egal = empiler_enfants_arbre_binaire(l_pile, &l_taille,
+					l_noeud1, &l_noeud1->second_enfant, l_noeud2,
+					&l_noeud2->second_enfant);
+			}
+			if (l_egal) {
+				l_egal = empiler_enfants_arbre_binaire(l_pile, &l_taille,
+					l_noeud1, &l_noeud1->premier_enfant, l_noeud2,
+					&l_noeud2->premier_enfant);
+			}
+		}
+		if (!l_racine) {
+			relacher_arbre_binaire(l_noeud1);
+			relacher_arbre_binaire(l_noeud2);
+		}
+		l_racine = false;
+	}
+	free(l_pile);
+	return l_egal;
+}
+
+/**
+ *  \brief Indique si deux arbres ont la mme structure et les mmes valeurs.
+ *
+ *  \param arbre1 Le premier arbre_binaire  comparer
+ *  \param arbre2 Le second arbre_binaire  comparer
+ *
+ *  \return true si les deux arbres ont le mme hachage, false sinon.
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas tre NULL
+ */
+bool egal_arbre_binaire(arbre_binaire* a_arbre1, arbre_binaire* a_arbre2)
+{
+	bool l_egal = true;
+	if (a_arbre1 != a_arbre2) {
+		l_egal = hachage_arbre_binaire(a_arbre1) ==
+			hachage_arbre_binaire(a_arbre2);
+	}
+	return l_egal;
+}
+
+/**
+ *  \brief Indique si deux arbres ont la mme structure et les mmes valeurs
+ *         en confirmant l'galit des hachages noeud par noeud.
+ *
+ *  \param arbre1 Le premier arbre_binaire  comparer
+ *  \param arbre2 Le second arbre_binaire  comparer
+ *
+ *  \return true si les deux arbres sont identiques, false sinon ou si la
+ *          mmoire a manqu.
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas tre NULL
+ */
+bool egal_strict_arbre_binaire(arbre_binaire* a_arbre1,
+		arbre_binaire* a_arbre2)
+{
+	bool l_egal = true;
+	if (a_arbre1 != a_arbre2) {
+		l_egal = egal_arbre_binaire(a_arbre1, a_arbre2) &&
+			structures_identiques_arbre_binaire(a_arbre1, a_arbre2);
+	}
+	return l_egal;
+}
+
+/**
+ *  \brief Signale une diffrence et renvoie le nombre de diffrences (1).
+ *
+ *  \param arbre1 Le noeud du premier arbre ou NULL
+ *  \param arbre2 Le noeud du second arbre ou NULL
+ *  \param fonction La fonction  appeler ou NULL
+ *  \param donnees Les donnes  donner  'fonction'
+ *
+ *  \return 1
+ */
+int signaler_difference_arbre_binaire(arbre_binaire* a_arbre1,
+		arbre_binaire* a_arbre2, fonction_difference_arbre_binaire a_fonction,
+		void* a_donnees)
+{
+	if (a_fonction) {
+		a_fonction(a_arbre1, a_arbre2, a_donnees);
+	}
+	return 1;
+}
+
+/**
+ *  \brief Trouve les diffrences entre deux arbres.
+ *
+ *  \param arbre1 L'arbre_binaire de dpart
+ *  \param arbre2 L'arbre_binaire  comparer avec 'arbre1'
+ *  \param fonction La fonction appele pour chaque diffrence ou NULL
+ *  \param donnees Les donnes  donner  'fonction'
+ *
+ *  \return Le nombre de diffrences trouves
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas tre NULL
+ */
+taille_arbre_binaire difference_arbre_binaire(arbre_binaire* a_arbre1,
+		arbre_binaire* a_arbre2, fonction_difference_arbre_binaire a_fonction,
+		void* a_donnees)
+{
+	taille_arbre_binaire l_nombre_differences = 0;
+	if (!egal_arbre_binaire(a_arbre1, a_arbre2)) {
+		if (a_arbre1->valeur != a_arbre2->valeur) {
+			l_nombre_differences = l_nombre_differences +
+				signaler_difference_arbre_binaire(a_arbre1, a_arbre2,
+				a_fonction, a_donnees);
+		}
+		if (a_arbre1->premier_enfant && a_arbre2->premier_enfant) {
+			l_nombre_differences = l_nombre_differences +
+				difference_arbre_binaire(a_arbre1->premier_enfant,
+				a_arbre2->premier_enfant, a_fonction, a_donnees);
+		} else if (a_arbre1->premier_enfant || a_arbre2->premier_enfant) {
+			l_nombre_differences = l_nombre_differences +
+				signaler_difference_arbre_binaire(a_arbre1->premier_enfant,
+				a_arbre2->premier_enfant, a_fonction, a_donnees);
+		}
+		if (a_arbre1->second_enfant && a_arbre2->second_enfant) {
+			l_nombre_differences = l_nombre_differences +
+				difference_arbre_binaire(a_arbre1->second_enfant,
+				a_arbre2->second_enfant, a_fonction, a_donnees);
+		} else if (a_arbre1->second_enfant || a_arbre2->second_enfant) {
+			l_nombre_differences = l_nombre_differences +
+				signaler_difference_arbre_binaire(a_arbre1->second_enfant,
+				a_arbre2->second_enfant, a_fonction, a_donnees);
+		}
+	}
+	return l_nombre_differences;
+}
+
+/**
+ *  \brief Place le 'sous_arbre' dans l'emplacement 'enfant' de l''arbre' en
+ *         le partageant.
+ *
+ *  \param arbre L'arbre_binaire qui reoit le 'sous_arbre'
+ *  \param enfant L'emplacement de l'enfant dans l''arbre'
+ *  \param sous_arbre L'arbre_binaire  partager
+ *  \param erreur Le texte de l'erreur si l'emplacement est occup
+ *
+ *  \note 'arbre', 'enfant' et 'sous_arbre' ne doivent pas tre NULL
+ */
+void partager_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire** a_enfant, arbre_binaire* a_sous_arbre,
+		const char* a_erreur)
+{
+	arbre_binaire* l_ancetre = a_arbre;
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		while (l_ancetre && l_ancetre != a_sous_arbre &&
+				!a_sous_arbre->partage) {
+			l_ancetre = l_ancetre->parent;
+		}
+		if (*a_enfant) {
+			inscrire_erreur_arbre_binaire(a_arbre, a_erreur);
+		} else if (l_ancetre == a_sous_arbre) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Le sous-arbre  partager contient l'arbre.");
+		} else {
+			ajouter_reference_arbre_binaire(a_sous_arbre);
+			*a_enfant = a_sous_arbre;
+			invalider_hachage_arbre_binaire(a_arbre);
+		}
+	}
+}
+
+/**
+ *  \brief Place le 'sous_arbre' comme premier enfant de l''arbre' sans le
+ *         copier.
+ *
+ *  \param arbre L'arbre_binaire qui reoit le premier enfant
+ *  \param sous_arbre L'arbre_binaire  partager
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas tre NULL
+ */
+void partager_premier_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_sous_arbre)
+{
+	partager_enfant_arbre_binaire(a_arbre, &a_arbre->premier_enfant,
+		a_sous_arbre, "Premier enfant dja existant.");
+}
+
+/**
+ *  \brief Place le 'sous_arbre' comme second enfant de l''arbre' sans le
+ *         copier.
+ *
+ *  \param arbre L'arbre_binaire qui reoit le second enfant
+ *  \param sous_arbre L'arbre_binaire  partager
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas tre NULL
+ */
+void partager_second_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_sous_arbre)
+{
+	partager_enfant_arbre_binaire(a_arbre, &a_arbre->second_enfant,
+		a_sous_arbre, "Second enfant dja existant.");
+}
+
+/**
+ *  \brief Indique si deux noeuds ont la mme valeur et les mmes enfants.
+ *
+ *  \param noeud1 Le premier noeud  comparer
+ *  \param noeud2 Le second noeud  comparer
+ *
+ *  \return true si les noeuds sont interchangeables, false sinon.
+ */
+bool noeuds_identiques_arbre_binaire(arbre_binaire* a_noeud1,
+		arbre_binaire* a_noeud2)
+{
+	return a_noeud1->valeur == a_noeud2->valeur &&
+		a_noeud1->premier_enfant == a_noeud2->premier_enfant &&
+		a_noeud1->second_enfant == a_noeud2->second_enfant;
+}
+
+/**
+ *  \brief Double la capacit de la 'table'.
+ *
+ *  \param table La table_partage_arbre_binaire  agrandir
+ *
+ *  \return true si la table a t agrandie, false sinon.
+ */
+bool agrandir_table_partage_arbre_binaire(table_partage_arbre_binaire* a_table)
+{
+	bool l_result = false;
+	size_t l_capacite = a_table->capacite * 2;
+	arbre_binaire** l_noeuds = calloc(l_capacite, sizeof(arbre_binaire*));
+	size_t l_i;
+	if (l_noeuds) {
+		for (l_i = 0; l_i < a_table->capacite; l_i = l_i + 1) {
+			if (a_table->noeuds[l_i]) {
+				size_t l_position =
+					hachage_arbre_binaire(a_table->noeuds[l_i]) &
+					(l_capacite - 1);
+				while (l_noeuds[l_position]) {
+					l_position = (l_position + 1) & (l_capacite - 1);
+				}
+				l_noeuds[l_position] = a_table->noeuds[l_i];
+			}
+		}
+		free(a_table->noeuds);
+		a_table->noeuds = l_noeuds;
+		a_table->capacite = l_capacite;
+		l_result = true;
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Retourne le noeud de la 'table' identique  l''arbre', dont les
+ *         enfants sont dj partags, en y ajoutant l''arbre' s'il n'y est
+ *         pas encore.
+ *
+ *  \param arbre L'arbre_binaire  partager
+ *  \param table La table des noeuds dj partags
+ *  \param nombre_liberes Incrment pour chaque noeud libr
+ *
+ *  \return Le noeud unique quivalent  l''arbre'
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+arbre_binaire* unifier_noeud_arbre_binaire(arbre_binaire* a_arbre,
+		table_partage_arbre_binaire* a_table,
+		taille_arbre_binaire* a_nombre_liberes)
+{
+	arbre_binaire* l_result = a_arbre;
+	if (!a_arbre->a_erreur && (a_table->nombre * 2 < a_table->capacite ||
+			agrandir_table_partage_arbre_binaire(a_table))) {
+		size_t l_position = hachage_arbre_binaire(a_arbre) &
+			(a_table->capacite - 1);
+		while (a_table->noeuds[l_position] &&
+				!noeuds_identiques_arbre_binaire(a_table->noeuds[l_position],
+				a_arbre)) {
+			l_position = (l_position + 1) & (a_table->capacite - 1);
+		}
+		if (!a_table->noeuds[l_position]) {
+			a_table->noeuds[l_position] = a_arbre;
+			a_table->nombre = a_table->nombre + 1;
+		} else if (a_table->noeuds[l_position] != a_arbre) {
+			l_result = a_table->noeuds[l_position];
+			ajouter_reference_arbre_binaire(l_result);
+			if (atomic_load(&a_arbre->references) == 1) {
+				*a_nombre_liberes = *a_nombre_liberes + 1;
+			}
+			detruire_arbre_binaire(a_arbre);
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Remplace le sous-arbre plac dans l''emplacement' par sa version
+ *         partage.
+ *
+ *  Les noeuds sont traits en ordre postfixe  l'aide d'une pile afin que les
+ *  enfants de chaque noeud soient partags avant lui. Les sous-arbres dj
+ *  partags ne sont pas parcourus.
+ *
+ *  \param emplacement L'emplacement du sous-arbre  partager
+ *  \param table La table des noeuds dj partags
+ *  \param nombre_liberes Incrment pour chaque noeud libr
+ *
+ *  \return true si le partage a russi, false si la mmoire a manqu.
+ *
+ *  \note 'emplacement' ne doit pas tre NULL et doit contenir un noeud
+ */
+bool partager_noeud_arbre_binaire(arbre_binaire** a_emplacement,
+		table_partage_arbre_binaire* a_table,
+		taille_arbre_binaire* a_nombre_liberes)
+{
+	bool l_result = true;
+	size_t l_capacite = 64;
+	size_t l_taille = 1;
+	parcours_partage_arbre_binaire* l_pile =
+		malloc(l_capacite * sizeof(parcours_partage_arbre_binaire));
+	arbre_binaire* l_noeud;
+	arbre_binaire** l_enfant;
+	void* l_nouveau;
+	if (l_pile) {
+		l_pile[0].emplacement = a_emplacement;
+		l_pile[0].etape = 0;
+	} else {
+		l_taille = 0;
+		l_result = false;
+	}
+	while (l_taille > 0) {
+		l_noeud = *l_pile[l_taille - 1].emplacement;
+		l_enfant = NULL;
+		if (l_pile[l_taille - 1].etape == 0) {
+			l_enfant = &l_noeud->premier_enfant;
+		} else if (l_pile[l_taille - 1].etape == 1) {
+			l_enfant = &l_noeud->second_enfant;
+		}
+		l_pile[l_taille - 1].etape = l_pile[l_taille - 1].etape + 1;
+		if (!l_enfant) {
+			*l_pile[l_taille - 1].emplacement = unifier_noeud_arbre_binaire(
+				l_noeud, a_table, a_nombre_liberes);
+			l_taille = l_taille - 1;
+		} else if (*l_enfant && !l_noeud->partage) {
+			if (l_taille == l_capacite) {
+				l_nouveau = realloc(l_pile, l_capacite * 2 *
+					sizeof(parcours_partage_arbre_binaire));
+				if (l_nouveau) {
+					l_pile = l_nouveau;
+					l_capacite = l_capacite * 2;
+				} else {
+					l_taille = 0;
+					l_result = false;
+				}
+			}
+			if (l_result) {
+				l_pile[l_taille].emplacement = l_enfant;
+				l_pile[l_taille].etape = 0;
+				l_taille = l_taille + 1;
+			}
+		}
+	}
+	free(l_pile);
+	return l_result;
+}
+
+/**
+ *  \brief Partage tous les sous-arbres identiques de l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire  compacter
+ *
+ *  \return Le nombre de noeuds librs
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+taille_arbre_binaire compacter_arbre_binaire(arbre_binaire* a_arbre)
+{
+	taille_arbre_binaire l_nombre_liberes = 0;
+	table_partage_arbre_binaire l_table;
+	l_table.capacite = 64;
+	l_table.nombre = 0;
+	l_table.noeuds = calloc(l_table.capacite, sizeof(arbre_binaire*));
+	if (!verifier_modifiable_arbre_binaire(a_arbre)) {
+		free(l_table.noeuds);
+	} else if (l_table.noeuds && materialiser_tout_arbre_binaire(a_arbre)) {
+		if (a_arbre->premier_enfant && !partager_noeud_arbre_binaire(
+				&a_arbre->premier_enfant, &l_table, &l_nombre_liberes)) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Ne peux pas allouer la mmoire.");
+		}
+		if (a_arbre->second_enfant && !partager_noeud_arbre_binaire(
+				&a_arbre->second_enfant, &l_table, &l_nombre_liberes)) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Ne peux pas allouer la mmoire.");
+		}
+		free(l_table.noeuds);
+	} else {
+		free(l_table.noeuds);
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la table de partage.");
+	}
+	return l_nombre_liberes;
+}
+
+/**
+ *  \brief Crer une table qui construit des arbres dont les sous-arbres
+ *         identiques sont partags ds leur cration.
+ *
+ *  \return La table_partage_arbre_binaire ou NULL en cas d'erreur
+ */
+table_partage_arbre_binaire* creer_table_partage_arbre_binaire(void)
+{
+	table_partage_arbre_binaire* l_result =
+		malloc(sizeof(table_partage_arbre_binaire));
+	if (l_result) {
+		l_result->capacite = 64;
+		l_result->nombre = 0;
+		l_result->noeuds = calloc(l_result->capacite, sizeof(arbre_binaire*));
+		if (!l_result->noeuds) {
+			free(l_result);
+			l_result = NULL;
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Dsalloue la 'table' en retirant sa rfrence vers chaque noeud.
+ *
+ *  \param table La table_partage_arbre_binaire  dsallouer
+ */
+void detruire_table_partage_arbre_binaire(table_partage_arbre_binaire* a_table)
+{
+	size_t l_i;
+	if (a_table) {
+		for (l_i = 0; l_i < a_table->capacite; l_i = l_i + 1) {
+			if (a_table->noeuds[l_i]) {
+				detruire_arbre_binaire(a_table->noeuds[l_i]);
+			}
+		}
+		free(a_table->noeuds);
+		free(a_table);
+	}
+}
+
+/**
+ *  \brief Retourne le noeud unique de la 'table' qui contient la 'valeur' et
+ *         les deux enfants, en le crant s'il n'existe pas encore.
+ *
+ *  La table conserve une rfrence vers chaque noeud qu'elle contient. Un
+ *  enfant qui n'a pas t construit par la 'table' est marqu comme partag
+ *  avec tous ses descendants puisque le nouveau noeud l'est.
+ *
+ *  \param table La table_partage_arbre_binaire
+ *  \param valeur La valeur  mettre dans la racine du noeud
+ *  \param premier_enfant Le premier enfant ou NULL
+ *  \param second_enfant Le second enfant ou NULL
+ *
+ *  \return Le noeud unique ou NULL en cas d'erreur
+ *
+ *  \note 'table' ne doit pas tre NULL
+ */
+arbre_binaire* construire_partage_arbre_binaire(
+		table_partage_arbre_binaire* a_table, valeur_arbre_binaire a_valeur,
+		arbre_binaire* a_premier_enfant, arbre_binaire* a_second_enfant)
+{
+	arbre_binaire* l_result = NULL;
+	arbre_binaire l_modele;
+	size_t l_position;
+	initialiser_arbre_binaire(&l_modele, a_valeur, NULL);
+	l_modele.premier_enfant = a_premier_enfant;
+	l_modele.second_enfant = a_second_enfant;
+	if (a_table->nombre * 2 < a_table->capacite ||
+			agrandir_table_partage_arbre_binaire(a_table)) {
+		l_position = hachage_arbre_binaire(&l_modele) &
+			(a_table->capacite - 1);
+		while (a_table->noeuds[l_position] &&
+				!noeuds_identiques_arbre_binaire(a_table->noeuds[l_position],
+				&l_modele)) {
+			l_position = (l_position + 1) & (a_table->capacite - 1);
+		}
+		if (a_table->noeuds[l_position]) {
+			l_result = a_table->noeuds[l_position];
+			atomic_fetch_add(&l_result->references, 1);
+		} else {
+			l_result = creer_arbre_binaire(a_valeur);
+		}
+		if (l_result && !a_table->noeuds[l_position]) {
+			if (a_premier_enfant && !a_premier_enfant->partage) {
+				marquer_partage_arbre_binaire(a_premier_enfant);
+				a_premier_enfant->parent = NULL;
+			}
+			if (a_second_enfant && !a_second_enfant->partage) {
+				marquer_partage_arbre_binaire(a_second_enfant);
+				a_second_enfant->parent = NULL;
+			}
+			l_result->premier_enfant = a_premier_enfant;
+			l_result->second_enfant = a_second_enfant;
+			l_result->hachage = l_modele.hachage;
+			l_result->hachage_valide = true;
+			l_result->partage = true;
+			atomic_init(&l_result->references, 2);
+			a_table->noeuds[l_position] = l_result;
+			a_table->nombre = a_table->nombre + 1;
+			a_premier_enfant = NULL;
+			a_second_enfant = NULL;
+		}
+	}
+	if (a_premier_enfant) {
+		detruire_arbre_binaire(a_premier_enfant);
+	}
+	if (a_second_enfant) {
+		detruire_arbre_binaire(a_second_enfant);
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Dsalloue les arbres dposs dans le 'recuperateur'.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire  traiter
+ *
+ *  \return NULL
+ */
+void* traiter_recuperateur_arbre_binaire(void* a_recuperateur)
+{
+	recuperateur_arbre_binaire* l_recuperateur = a_recuperateur;
+	arbre_binaire* l_arbre;
+	bool l_continuer = true;
+	pthread_mutex_lock(&l_recuperateur->verrou);
+	while (l_continuer) {
+		while (l_recuperateur->nombre == 0 && !l_recuperateur->arret) {
+			pthread_cond_wait(&l_recuperateur->condition_ajout,
+				&l_recuperateur->verrou);
+		}
+		if (l_recuperateur->nombre > 0) {
+			l_arbre = l_recuperateur->file[l_recuperateur->debut];
+			l_recuperateur->debut = (l_recuperateur->debut + 1) %
+				l_recuperateur->capacite;
+			l_recuperateur->nombre = l_recuperateur->nombre - 1;
+			l_recuperateur->en_cours = 1;
+			pthread_cond_broadcast(&l_recuperateur->condition_retrait);
+			pthread_mutex_unlock(&l_recuperateur->verrou);
+			detruire_arbre_binaire(l_arbre);
+			pthread_mutex_lock(&l_recuperateur->verrou);
+			l_recuperateur->en_cours = 0;
+			pthread_cond_broadcast(&l_recuperateur->condition_retrait);
+		} else {
+			l_continuer = false;
+		}
+	}
+	pthread_mutex_unlock(&l_recuperateur->verrou);
+	return NULL;
+}
+
+/**
+ *  \brief Crer un rcuprateur qui dsalloue les arbres en arrire-plan.
+ *
+ *  \param capacite Le nombre maximal d'arbres en attente de dsallocation
+ *
+ *  \return Le recuperateur_arbre_binaire ou NULL en cas d'erreur
+ */
+recuperateur_arbre_binaire* creer_recuperateur_arbre_binaire(int a_capacite)
+{
+	recuperateur_arbre_binaire* l_result = NULL;
+	if (a_capacite > 0) {
+		l_result = calloc(1, sizeof(recuperateur_arbre_binaire));
+	}
+	if (l_result) {
+		l_result->file = calloc(a_capacite, sizeof(arbre_binaire*));
+		l_result->capacite = a_capacite;
+		l_result->debut = 0;
+		l_result->nombre = 0;
+		l_result->en_cours = 0;
+		l_result->arret = false;
+		pthread_mutex_init(&l_result->verrou, NULL);
+		pthread_cond_init(&l_result->condition_ajout, NULL);
+		pthread_cond_init(&l_result->condition_retrait, NULL);
+		if (!l_result->file || pthread_create(&l_result->fil, NULL,
+				traiter_recuperateur_arbre_binaire, l_result) != 0) {
+			pthread_cond_destroy(&l_result->condition_retrait);
+			pthread_cond_destroy(&l_result->condition_ajout);
+			pthread_mutex_destroy(&l_result->verrou);
+			free(l_result->file);
+			free(l_result);
+			l_result = NULL;
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Dsalloue tous les arbres en attente puis le 'recuperateur'.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire  dsallouer
+ */
+void detruire_recuperateur_arbre_binaire(
+		recuperateur_arbre_binaire* a_recuperateur)
+{
+	pthread_mutex_lock(&a_recuperateur->verrou);
+	a_recuperateur->arret = true;
+	pthread_cond_broadcast(&a_recuperateur->condition_ajout);
+	pthread_mutex_unlock(&a_recuperateur->verrou);
+	pthread_join(a_recuperateur->fil, NULL);
+	pthread_cond_destroy(&a_recuperateur->condition_retrait);
+	pthread_cond_destroy(&a_recuperateur->condition_ajout);
+	pthread_mutex_destroy(&a_recuperateur->verrou);
+	free(a_recuperateur->file);
+	free(a_recuperateur);
+}
+
+/**
+ *  \brief Attend que tous les arbres dposs dans le 'recuperateur' soient
+ *         dsallous.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire
+ *
+ *  \note 'recuperateur' ne doit pas tre NULL
+ */
+void vider_recuperateur_arbre_binaire(
+		recuperateur_arbre_binaire* a_recuperateur)
+{
+	pthread_mutex_lock(&a_recuperateur->verrou);
+	while (a_recuperateur->nombre > 0 || a_recuperateur->en_cours > 0) {
+		pthread_cond_wait(&a_recuperateur->condition_retrait,
+			&a_recuperateur->verrou);
+	}
+	pthread_mutex_unlock(&a_recuperateur->verrou);
+}
+
+/**
+ *  \brief Renvoie le nombre d'arbres qui ne sont pas encore dsallous.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire
+ *
+ *  \return Le nombre d'arbres en attente de dsallocation
+ *
+ *  \note 'recuperateur' ne doit pas tre NULL
+ */
+int en_attente_recuperateur_arbre_binaire(
+		recuperateur_arbre_binaire* a_recuperateur)
+{
+	int l_nombre;
+	pthread_mutex_lock(&a_recuperateur->verrou);
+	l_nombre = a_recuperateur->nombre + a_recuperateur->en_cours;
+	pthread_mutex_unlock(&a_recuperateur->verrou);
+	return l_nombre;
+}
+
+/**
+ *  \brief Effectue la dsallocation d'un arbre_binaire en arrire-plan.
+ *
+ *  \param arbre L'arbre_binaire  dsallouer
+ *  \param recuperateur Le recuperateur_arbre_binaire qui dsalloue l''arbre'
+ *
+ *  \note 'arbre' et 'recuperateur' ne doivent pas tre NULL
+ */
+void detruire_differe_arbre_binaire(arbre_binaire* a_arbre,
+		recuperateur_arbre_binaire* a_recuperateur)
+{
+	pthread_mutex_lock(&a_recuperateur->verrou);
+	while (a_recuperateur->nombre == a_recuperateur->capacite) {
+		pthread_cond_wait(&a_recuperateur->condition_retrait,
+			&a_recuperateur->verrou);
+	}
+	a_recuperateur->file[(a_recuperateur->debut + a_recuperateur->nombre) %
+		a_recuperateur->capacite] = a_arbre;
+	a_recuperateur->nombre = a_recuperateur->nombre + 1;
+	pthread_cond_signal(&a_recuperateur->condition_ajout);
+	pthread_mutex_unlock(&a_recuperateur->verrou);
+}
+
+/**
+ *  \brief Retire le premier enfant d'un 'arbre' et le dsalloue en
+ *         arrire-plan.
+ *
+ *  \param arbre L'arbre_binaire  retirer le premier enfant
+ *  \param recuperateur Le recuperateur_arbre_binaire qui dsalloue l'enfant
+ *
+ *  \note 'arbre' et 'recuperateur' ne doivent pas tre NULL
+ */
+void retirer_premier_enfant_differe_arbre_binaire(arbre_binaire* a_arbre,
+		recuperateur_arbre_binaire* a_recuperateur)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (a_arbre->premier_enfant) {
+			detruire_differe_arbre_binaire(a_arbre->premier_enfant,
+				a_recuperateur);
+			a_arbre->premier_enfant = NULL;
+			invalider_hachage_arbre_binaire(a_arbre);
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Aucun premier enfant  enlever.");
+		}
+	}
+}
+
+/**
+ *  \brief Retire le second enfant d'un 'arbre' et le dsalloue en
+ *         arrire-plan.
+ *
+ *  \param arbre L'arbre_binaire  retirer le second enfant
+ *  \param recuperateur Le recuperateur_arbre_binaire qui dsalloue l'enfant
+ *
+ *  \note 'arbre' et 'recuperateur' ne doivent pas tre NULL
+ */
+void retirer_second_enfant_differe_arbre_binaire(arbre_binaire* a_arbre,
+		recuperateur_arbre_binaire* a_recuperateur)
+{
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (a_arbre->second_enfant) {
+			detruire_differe_arbre_binaire(a_arbre->second_enfant,
+				a_recuperateur);
+			a_arbre->second_enfant = NULL;
+			invalider_hachage_arbre_binaire(a_arbre);
+		} else {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Aucun second enfant  enlever.");
+		}
+	}
+}
+
+/**
+ *  \brief Dplace le contenu du noeud 'source' dans le noeud 'destination'.
+ *
+ *  Les enfants de la 'source' deviennent les enfants de la 'destination'.
+ *  Le parent et les rfrences de la 'destination' ne sont pas modifis.
+ *
+ *  \param destination Le noeud qui reoit le contenu
+ *  \param source Le noeud dont le contenu est dplac
+ *
+ *  \note 'destination' et 'source' ne doivent pas tre NULL
+ */
+void deplacer_noeud_arbre_binaire(arbre_binaire* a_destination,
+		arbre_binaire* a_source)
+{
+	a_destination->premier_enfant = a_source->premier_enfant;
+	if (a_destination->premier_enfant) {
+		a_destination->premier_enfant->parent = a_destination;
+	}
+	a_destination->second_enfant = a_source->second_enfant;
+	if (a_destination->second_enfant) {
+		a_destination->second_enfant->parent = a_destination;
+	}
+	a_destination->valeur = a_source->valeur;
+	a_destination->a_erreur = a_source->a_erreur;
+	a_destination->erreur = a_source->erreur;
+	a_destination->hachage = a_source->hachage;
+	a_destination->hachage_valide = a_source->hachage_valide;
+	a_destination->differe = a_source->differe;
+	if (a_destination->differe) {
+		a_destination->differe->noeud = a_destination;
+	}
+	a_destination->paresseux = a_source->paresseux;
+	a_destination->partage = a_source->partage;
+}
+
+/**
+ *  \brief Transforme l'arbre plac comme second enfant de la 'racine' en
+ *         une liste de seconds enfants, dans l'ordre infixe.
+ *
+ *  Les sous-arbres partags rencontrs sont copis.
+ *
+ *  \param racine Le noeud qui prcde la liste
+ *
+ *  \return Le nombre de noeuds dans la liste
+ *
+ *  \note 'racine' ne doit pas tre NULL
+ */
+taille_arbre_binaire arbre_vers_liste_arbre_binaire(arbre_binaire* a_racine)
+{
+	taille_arbre_binaire l_nombre = 0;
+	arbre_binaire* l_queue = a_racine;
+	arbre_binaire* l_reste = a_racine->second_enfant;
+	arbre_binaire* l_enfant;
+	while (l_reste) {
+		l_reste->hachage_valide = false;
+		if (l_reste->premier_enfant) {
+			l_enfant = enfant_unique_arbre_binaire(l_queue,
+				l_reste->premier_enfant);
+			l_reste->premier_enfant = l_enfant->second_enfant;
+			l_enfant->second_enfant = l_reste;
+			l_reste->parent = l_enfant;
+			l_queue->second_enfant = l_enfant;
+			l_reste = l_enfant;
+		} else {
+			l_nombre = l_nombre + 1;
+			l_queue = l_reste;
+			l_reste = l_reste->second_enfant;
+			if (l_reste) {
+				l_reste = enfant_unique_arbre_binaire(l_queue, l_reste);
+				l_queue->second_enfant = l_reste;
+			}
+		}
+	}
+	return l_nombre;
+}
+
+/**
+ *  \brief Effectue 'nombre' rotations vers la gauche le long de la liste de
+ *         seconds enfants de la 'racine'.
+ *
+ *  \param racine Le noeud qui prcde la liste
+ *  \param nombre Le nombre de rotations  effectuer
+ *
+ *  \note 'racine' ne doit pas tre NULL
+ */
+void compresser_liste_arbre_binaire(arbre_binaire* a_racine,
+		taille_arbre_binaire a_nombre)
+{
+	arbre_binaire* l_parcours = a_racine;
+	arbre_binaire* l_enfant;
+	taille_arbre_binaire l_i;
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		l_enfant = l_parcours->second_enfant;
+		l_parcours->second_enfant = l_enfant->second_enfant;
+		l_parcours->second_enfant->parent = l_parcours;
+		l_parcours = l_parcours->second_enfant;
+		l_enfant->second_enfant = l_parcours->premier_enfant;
+		if (l_enfant->second_enfant) {
+			l_enfant->second_enfant->parent = l_enfant;
+		}
+		l_parcours->premier_enfant = l_enfant;
+		l_enfant->parent = l_parcours;
+	}
+}
+
+/**
+ *  \brief Reconstruit l''arbre' pour qu'il ait la plus petite hauteur
+ *         possible en conservant l'ordre infixe de ses valeurs.
+ *
+ *  \param arbre L'arbre_binaire  quilibrer
+ *
+ *  \return true si l''arbre' a t quilibr, false s'il est partag ou si
+ *          la mmoire n'a pu tre alloue.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool equilibrer_arbre_binaire(arbre_binaire* a_arbre)
+{
+	bool l_resultat = false;
+	arbre_binaire l_pseudo_racine;
+	arbre_binaire l_racine;
+	arbre_binaire* l_nouvelle_racine;
+	taille_arbre_binaire l_nombre;
+	taille_arbre_binaire l_feuilles = 1;
+	if (verifier_modifiable_arbre_binaire(a_arbre) &&
+			!materialiser_tout_arbre_binaire(a_arbre)) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire.");
+	} else if (!a_arbre->partage) {
+		atomic_init(&l_racine.references, 1);
+		deplacer_noeud_arbre_binaire(&l_racine, a_arbre);
+		initialiser_arbre_binaire(&l_pseudo_racine, 0, NULL);
+		l_pseudo_racine.second_enfant = &l_racine;
+		l_racine.parent = &l_pseudo_racine;
+		l_nombre = arbre_vers_liste_arbre_binaire(&l_pseudo_racine);
+		while (l_feuilles <= (l_nombre + 1) / 2) {
+			l_feuilles = l_feuilles * 2;
+		}
+		compresser_liste_arbre_binaire(&l_pseudo_racine,
+			l_nombre + 1 - l_feuilles);
+		l_nombre = l_feuilles - 1;
+		while (l_nombre > 1) {
+			l_nombre = l_nombre / 2;
+			compresser_liste_arbre_binaire(&l_pseudo_racine, l_nombre);
+		}
+		l_nouvelle_racine = l_pseudo_racine.second_enfant;
+		deplacer_noeud_arbre_binaire(a_arbre, l_nouvelle_racine);
+		if (l_nouvelle_racine != &l_racine) {
+			deplacer_noeud_arbre_binaire(l_nouvelle_racine, &l_racine);
+			l_nouvelle_racine->parent = l_racine.parent;
+			if (l_racine.parent->premier_enfant == &l_racine) {
+				l_racine.parent->premier_enfant = l_nouvelle_racine;
+			} else {
+				l_racine.parent->second_enfant = l_nouvelle_racine;
+			}
+		}
+		a_arbre->hachage_valide = false;
+		if (a_arbre->parent) {
+			invalider_hachage_arbre_binaire(a_arbre->parent);
+		}
+		l_resultat = true;
+	}
+	return l_resultat;
+}
+
+/**
+ *  \brief quilibre l''arbre' si sa hauteur dpasse 'facteur' fois la
+ *         hauteur minimale.
+ *
+ *  \param arbre L'arbre_binaire  quilibrer
+ *  \param facteur Le rapport maximal entre la hauteur et la hauteur minimale
+ *
+ *  \return true si l''arbre' a t quilibr, false s'il n'avait pas 
+ *          l'tre ou si 'equilibrer_arbre_binaire' a chou.
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+bool equilibrer_si_necessaire_arbre_binaire(arbre_binaire* a_arbre,
+		double a_facteur)
+{
+	bool l_equilibre = false;
+	taille_arbre_binaire l_nombre;
+	taille_arbre_binaire l_hauteur;
+	taille_arbre_binaire l_hauteur_minimale = 0;
+	if (mesurer_arbre_binaire(a_arbre, &l_nombre, &l_hauteur)) {
+		while (l_nombre > 0) {
+			l_hauteur_minimale = l_hauteur_minimale + 1;
+			l_nombre = l_nombre / 2;
+		}
+		if (l_hauteur > a_facteur * l_hauteur_minimale) {
+			l_equilibre = equilibrer_arbre_binaire(a_arbre);
+		}
+	} else {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire pour mesurer l'arbre.");
+	}
+	return l_equilibre;
+}
+
+/**
+ *  \brief crit le tampon dj srialis d'un 'fichier' d'un lot.
+ *
+ *  L'erreur ventuelle est note dans le 'fichier' et non dans son arbre,
+ *  qui peut apparatre plusieurs fois dans le lot.
+ *
+ *  \param fichier Le fichier_lot_arbre_binaire  crire
+ */
+void ecrire_fichier_lot_arbre_binaire(fichier_lot_arbre_binaire* a_fichier)
+{
+	FILE* l_fichier = fopen(a_fichier->nom_fichier, "wb");
+	if (l_fichier) {
+		if (fwrite(a_fichier->tampon, 1, a_fichier->taille, l_fichier) !=
+				a_fichier->taille) {
+			a_fichier->erreur = "Ne peux pas crire dans le fichier.";
+		}
+		if (fclose(l_fichier) != 0 && !a_fichier->erreur) {
+			a_fichier->erreur = "Ne peux pas crire dans le fichier.";
+		}
+	} else {
+		a_fichier->erreur = "Ne peux pas ouvrir le fichier en criture.";
+	}
+	a_fichier->etape = ETAPE_TERMINEE;
+}
+
+/**
+ *  \brief Traite les fichiers d'un 'lot' un  un avec les routines
+ *         'ecrire_fichier_lot_arbre_binaire' et 'charger_arbre_binaire'.
+ *
+ *  Plusieurs fils d'excution peuvent traiter le mme 'lot' en parallle.
+ *  Les fichiers dj termins sont ignors.
+ *
+ *  \param lot Le lot_arbre_binaire  traiter
+ *
+ *  \return NULL
+ */
+void* traiter_fils_lot_arbre_binaire(void* a_lot)
+{
+	lot_arbre_binaire* l_lot = a_lot;
+	fichier_lot_arbre_binaire* l_fichier;
+	int l_indice = atomic_fetch_add(&l_lot->suivant, 1);
+	while (l_indice < l_lot->nombre) {
+		l_fichier = &l_lot->fichiers[l_indice];
+		if (l_fichier->etape == ETAPE_TERMINEE) {
+			l_fichier = NULL;
+		} else if (l_lot->ecriture) {
+			ecrire_fichier_lot_arbre_binaire(l_fichier);
+		} else {
+			l_fichier->arbre = charger_arbre_binaire(l_fichier->nom_fichier);
+		}
+		l_indice = atomic_fetch_add(&l_lot->suivant, 1);
+	}
+	return NULL;
+}
+
+/**
+ *  \brief Traite un 'lot'  l'aide d'un groupe de fils d'excution.
+ *
+ *  \param lot Le lot_arbre_binaire  traiter
+ */
+void executer_fils_lot_arbre_binaire(lot_arbre_binaire* a_lot)
+{
+	pthread_t l_fils[64];
+	int l_nombre_fils = (int)sysconf(_SC_NPROCESSORS_ONLN) * 4;
+	int l_lances = 0;
+	int l_i;
+	if (l_nombre_fils > 64) {
+		l_nombre_fils = 64;
+	}
+	if (l_nombre_fils > a_lot->nombre) {
+		l_nombre_fils = a_lot->nombre;
+	}
+	atomic_init(&a_lot->suivant, 0);
+	for (l_i = 0; l_i < l_nombre_fils; l_i = l_i + 1) {
+		if (pthread_create(&l_fils[l_lances], NULL,
+				traiter_fils_lot_arbre_binaire, a_lot) == 0) {
+			l_lances = l_lances + 1;
+		}
+	}
+	traiter_fils_lot_arbre_binaire(a_lot);
+	for (l_i = 0; l_i < l_lances; l_i = l_i + 1) {
+		pthread_join(l_fils[l_i], NULL);
+	}
+}
+
+#ifdef ARBRE_BINAIRE_IO_URING
+/**
+ *  \brief Indique si le noyau prend en charge les oprations utilises par
+ *         les lots sur l'io_uring 'descripteur'.
+ *
+ *  \param descripteur Le descripteur de l'io_uring
+ *
+ *  \return true si l'ouverture, la lecture, l'criture et la fermeture sont
+ *          prises en charge, false sinon.
+ */
+bool verifier_operations_anneau_arbre_binaire(int a_descripteur)
+{
+	bool l_result = false;
+	int l_operations[4] = {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE,
+		IORING_OP_CLOSE};
+	struct io_uring_probe* l_sonde = calloc(1, sizeof(struct io_uring_probe) +
+		IORING_OP_LAST * sizeof(struct io_uring_probe_op));
+	int l_i;
+	if (l_sonde) {
+		if (syscall(__NR_io_uring_register, a_descripteur,
+				IORING_REGISTER_PROBE, l_sonde, IORING_OP_LAST) >= 0) {
+			l_result = true;
+			for (l_i = 0; l_i < 4; l_i = l_i + 1) {
+				if (l_operations[l_i] > l_sonde->last_op ||
+						!(l_sonde->ops[l_operations[l_i]].flags &
+						IO_URING_OP_SUPPORTED)) {
+					l_result = false;
+				}
+			}
+		}
+		free(l_sonde);
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Crer un io_uring.
+ *
+ *  \param anneau L'anneau_arbre_binaire  initialiser
+ *  \param entrees Le nombre d'entres de la file de soumission
+ *
+ *  \return true si l'io_uring est disponible et prend en charge les
+ *          oprations des lots, false sinon.
+ */
+bool ouvrir_anneau_arbre_binaire(anneau_arbre_binaire* a_anneau,
+		unsigned int a_entrees)
+{
+	bool l_result = false;
+	struct io_uring_params l_parametres;
+	char* l_soumission;
+	char* l_completion;
+	memset(a_anneau, 0, sizeof(anneau_arbre_binaire));
+	memset(&l_parametres, 0, sizeof(struct io_uring_params));
+	a_anneau->descripteur = (int)syscall(__NR_io_uring_setup, a_entrees,
+		&l_parametres);
+	if (a_anneau->descripteur >= 0) {
+		a_anneau->entrees = l_parametres.sq_entries;
+		a_anneau->taille_soumission = l_parametres.sq_off.array +
+			l_parametres.sq_entries * sizeof(unsigned int);
+		a_anneau->taille_completion = l_parametres.cq_off.cqes +
+			l_parametres.cq_entries * sizeof(struct io_uring_cqe);
+		if (l_parametres.features & IORING_FEAT_SINGLE_MMAP) {
+			if (a_anneau->taille_completion > a_anneau->taille_soumission) {
+				a_anneau->taille_soumission = a_anneau->taille_completion;
+			}
+			a_anneau->taille_completion = 0;
+		}
+		a_anneau->taille_soumissions = l_parametres.sq_entries *
+			sizeof(struct io_uring_sqe);
+		a_anneau->region_soumission = mmap(NULL,
+			a_anneau->taille_soumission, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, a_anneau->descripteur,
+			IORING_OFF_SQ_RING);
+		if (a_anneau->taille_completion) {
+			a_anneau->region_completion = mmap(NULL,
+				a_anneau->taille_completion, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, a_anneau->descripteur,
+				IORING_OFF_CQ_RING);
+		} else {
+			a_anneau->region_completion = a_anneau->region_soumission;
+		}
+		a_anneau->soumissions = mmap(NULL, a_anneau->taille_soumissions,
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			a_anneau->descripteur, IORING_OFF_SQES);
+		if (a_anneau->region_soumission != MAP_FAILED &&
+				a_anneau->region_completion != MAP_FAILED &&
+				a_anneau->soumissions != MAP_FAILED &&
+				verifier_operations_anneau_arbre_binaire(
+				a_anneau->descripteur)) {
+			l_soumission = a_anneau->region_soumission;
+			l_completion = a_anneau->region_completion;
+			a_anneau->soumission_tete = (unsigned int*)(l_soumission +
+				l_parametres.sq_off.head);
+			a_anneau->soumission_queue = (unsigned int*)(l_soumission +
+				l_parametres.sq_off.tail);
+			a_anneau->soumission_masque = (unsigned int*)(l_soumission +
+				l_parametres.sq_off.ring_mask);
+			a_anneau->soumission_tableau = (unsigned int*)(l_soumission +
+				l_parametres.sq_off.array);
+			a_anneau->completion_tete = (unsigned int*)(l_completion +
+				l_parametres.cq_off.head);
+			a_anneau->completion_queue = (unsigned int*)(l_completion +
+				l_parametres.cq_off.tail);
+			a_anneau->completion_masque = (unsigned int*)(l_completion +
+				l_parametres.cq_off.ring_mask);
+			a_anneau->completions = (struct io_uring_cqe*)(l_completion +
+				l_parametres.cq_off.cqes);
+			l_result = true;
+		} else {
+			if (a_anneau->soumissions != MAP_FAILED) {
+				munmap(a_anneau->soumissions, a_anneau->taille_soumissions);
+			}
+			if (a_anneau->taille_completion &&
+					a_anneau->region_completion != MAP_FAILED) {
+				munmap(a_anneau->region_completion,
+					a_anneau->taille_completion);
+			}
+			if (a_anneau->region_soumission != MAP_FAILED) {
+				munmap(a_anneau->region_soumission,
+					a_anneau->taille_soumission);
+			}
+			close(a_anneau->descripteur);
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Libre un io_uring cr par 'ouvrir_anneau_arbre_binaire'.
+ *
+ *  \param anneau L'anneau_arbre_binaire  librer
+ */
+void fermer_anneau_arbre_binaire(anneau_arbre_binaire* a_anneau)
+{
+	munmap(a_anneau->soumissions, a_anneau->taille_soumissions);
+	if (a_anneau->taille_completion) {
+		munmap(a_anneau->region_completion, a_anneau->taille_completion);
+	}
+	munmap(a_anneau->region_soumission, a_anneau->taille_soumission);
+	close(a_anneau->descripteur);
+}
+
+/**
+ *  \brief Ajoute  l''anneau' l'opration correspondant  l'tape courante
+ *         du 'fichier'.
+ *
+ *  \param anneau L'anneau_arbre_binaire
+ *  \param lot Le lot_arbre_binaire qui contient le 'fichier'
+ *  \param indice L'indice du fichier dans le 'lot'
+ */
+void soumettre_anneau_arbre_binaire(anneau_arbre_binaire* a_anneau,
+		lot_arbre_binaire* a_lot, int a_indice)
+{
+	fichier_lot_arbre_binaire* l_fichier = &a_lot->fichiers[a_indice];
+	unsigned int l_queue = *a_anneau->soumission_queue;
+	unsigned int l_position = l_queue & *a_anneau->soumission_masque;
+	struct io_uring_sqe* l_soumission = &a_anneau->soumissions[l_position];
+	memset(l_soumission, 0, sizeof(struct io_uring_sqe));
+	l_soumission->user_data = (uint64_t)a_indice;
+	if (l_fichier->etape == ETAPE_OUVRIR) {
+		l_soumission->opcode = IORING_OP_OPENAT;
+		l_soumission->fd = AT_FDCWD;
+		l_soumission->addr = (uint64_t)(uintptr_t)l_fichier->nom_fichier;
+		if (a_lot->ecriture) {
+			l_soumission->len = 0666;
+			l_soumission->open_flags = O_WRONLY | O_CREAT | O_TRUNC;
+		} else {
+			l_soumission->open_flags = O_RDONLY;
+		}
+	} else if (l_fichier->etape == ETAPE_TRANSFERER) {
+		if (a_lot->ecriture) {
+			l_soumission->opcode = IORING_OP_WRITE;
+		} else {
+			l_soumission->opcode = IORING_OP_READ;
+		}
+		l_soumission->fd = l_fichier->descripteur;
+		l_soumission->addr = (uint64_t)(uintptr_t)(l_fichier->tampon +
+			l_fichier->fait);
+		l_soumission->len = (unsigned int)(l_fichier->taille -
+			l_fichier->fait);
+		l_soumission->off = l_fichier->fait;
+	} else {
+		l_soumission->opcode = IORING_OP_CLOSE;
+		l_soumission->fd = l_fichier->descripteur;
+	}
+	a_anneau->soumission_tableau[l_position] = l_position;
+	__atomic_store_n(a_anneau->soumission_queue, l_queue + 1,
+		__ATOMIC_RELEASE);
+}
+
+/**
+ *  \brief Fait avancer le 'fichier'  l'tape suivante selon le 'resultat'
+ *         de son opration.
+ *
+ *  \param lot Le lot_arbre_binaire qui contient le 'fichier'
+ *  \param fichier Le fichier dont l'opration est termine
+ *  \param resultat Le rsultat de l'opration
+ */
+void completer_fichier_lot_arbre_binaire(lot_arbre_binaire* a_lot,
+		fichier_lot_arbre_binaire* a_fichier, int a_resultat)
+{
+	size_t l_demande = a_fichier->taille - a_fichier->fait;
+	char* l_tampon;
+	if (a_fichier->etape == ETAPE_OUVRIR) {
+		if (a_resultat >= 0) {
+			a_fichier->descripteur = a_resultat;
+			a_fichier->etape = ETAPE_TRANSFERER;
+			if (a_lot->ecriture && a_fichier->taille == 0) {
+				a_fichier->etape = ETAPE_FERMER;
+			}
+		} else if (a_lot->ecriture) {
+			a_fichier->erreur = "Ne peux pas ouvrir le fichier en criture.";
+			a_fichier->etape = ETAPE_TERMINEE;
+		} else {
+			a_fichier->erreur = "Ne peux pas ouvrir le fichier en lecture.";
+			a_fichier->etape = ETAPE_TERMINEE;
+		}
+	} else if (a_fichier->etape == ETAPE_TRANSFERER) {
+		if (a_resultat < 0 || (a_resultat == 0 && a_lot->ecriture)) {
+			if (a_lot->ecriture) {
+				a_fichier->erreur = "Ne peux pas crire dans le fichier.";
+			} else {
+				a_fichier->erreur = "Ne peux pas lire le fichier.";
+			}
+			a_fichier->etape = ETAPE_FERMER;
+		} else {
+			a_fichier->fait = a_fichier->fait + a_resultat;
+			if (a_lot->ecriture) {
+				if (a_fichier->fait == a_fichier->taille) {
+					a_fichier->etape = ETAPE_FERMER;
+				}
+			} else if ((size_t)a_resultat < l_demande) {
+				a_fichier->etape = ETAPE_FERMER;
+			} else {
+				l_tampon = realloc(a_fichier->tampon, a_fichier->taille * 2);
+				if (l_tampon) {
+					a_fichier->tampon = l_tampon;
+					a_fichier->taille = a_fichier->taille * 2;
+				} else {
+					a_fichier->erreur = "Ne peux pas lire le fichier.";
+					a_fichier->etape = ETAPE_FERMER;
+				}
+			}
+		}
+	} else {
+		if (a_resultat < 0 && a_lot->ecriture && !a_fichier->erreur) {
+			a_fichier->erreur = "Ne peux pas crire dans le fichier.";
+		}
+		a_fichier->etape = ETAPE_TERMINEE;
+	}
+}
+
+/**
+ *  \brief Termine en erreur les fichiers du 'lot' qui ne le sont pas encore,
+ *         lorsque l'io_uring ne peut plus tre utilis.
+ *
+ *  Les descripteurs des fichiers qui attendent dans 'prets' sont ferms.
+ *  Ceux des oprations dj confies au noyau sont abandonns.
+ *
+ *  \param lot Le lot_arbre_binaire  terminer
+ *  \param prets La file circulaire des fichiers qui ne sont pas en cours
+ *  \param debut La position du premier fichier dans 'prets'
+ *  \param nombre_prets Le nombre de fichiers dans 'prets'
+ */
+void abandonner_anneau_lot_arbre_binaire(lot_arbre_binaire* a_lot,
+		int* a_prets, int a_debut, int a_nombre_prets)
+{
+	fichier_lot_arbre_binaire* l_fichier;
+	int l_i;
+	for (l_i = 0; l_i < a_nombre_prets; l_i = l_i + 1) {
+		l_fichier = &a_lot->fichiers[a_prets[(a_debut + l_i) %
+			a_lot->nombre]];
+		if (l_fichier->etape != ETAPE_OUVRIR) {
+			close(l_fichier->descripteur);
+		}
+	}
+	for (l_i = 0; l_i < a_lot->nombre; l_i = l_i + 1) {
+		l_fichier = &a_lot->fichiers[l_i];
+		if (l_fichier->etape != ETAPE_TERMINEE) {
+			if (!l_fichier->erreur && a_lot->ecriture) {
+				l_fichier->erreur = "Ne peux pas crire dans le fichier.";
+			} else if (!l_fichier->erreur) {
+				l_fichier->erreur = "Ne peux pas lire le fichier.";
+			}
+			l_fichier->etape = ETAPE_TERMINEE;
+		}
+	}
+}
+
+/**
+ *  \brief Traite un 'lot'  l'aide d'un io_uring.
+ *
+ *  Chaque fichier passe par l'ouverture, le transfert et la fermeture
+ *  indpendamment des autres, avec au plus 'LOT_OPERATIONS' oprations en
+ *  cours. Les soumissions partielles ou interrompues par un signal sont
+ *  reprises  l'appel suivant.
+ *
+ *  \param lot Le lot_arbre_binaire  traiter
+ *
+ *  \return true si l'io_uring est disponible, false sinon.
+ */
+bool executer_anneau_lot_arbre_binaire(lot_arbre_binaire* a_lot)
+{
+	anneau_arbre_binaire l_anneau;
+	bool l_result = ouvrir_anneau_arbre_binaire(&l_anneau, LOT_OPERATIONS);
+	int* l_prets = NULL;
+	int l_debut = 0;
+	int l_nombre_prets = 0;
+	int l_termines = 0;
+	unsigned int l_en_cours = 0;
+	unsigned int l_a_soumettre;
+	long l_retour;
+	unsigned int l_tete;
+	struct io_uring_cqe* l_completion;
+	fichier_lot_arbre_binaire* l_fichier;
+	int l_i;
+	if (l_result) {
+		l_prets = malloc(a_lot->nombre * sizeof(int));
+		if (!l_prets) {
+			fermer_anneau_arbre_binaire(&l_anneau);
+			l_result = false;
+		}
+	}
+	if (l_result) {
+		for (l_i = 0; l_i < a_lot->nombre; l_i = l_i + 1) {
+			if (a_lot->fichiers[l_i].etape == ETAPE_TERMINEE) {
+				l_termines = l_termines + 1;
+			} else {
+				l_prets[l_nombre_prets] = l_i;
+				l_nombre_prets = l_nombre_prets + 1;
+			}
+		}
+		while (l_termines < a_lot->nombre) {
+			while (l_nombre_prets > 0 && l_en_cours < l_anneau.entrees) {
+				soumettre_anneau_arbre_binaire(&l_anneau, a_lot,
+					l_prets[l_debut]);
+				l_debut = (l_debut + 1) % a_lot->nombre;
+				l_nombre_prets = l_nombre_prets - 1;
+				l_en_cours = l_en_cours + 1;
+			}
+			do {
+				l_a_soumettre = *l_anneau.soumission_queue -
+					__atomic_load_n(l_anneau.soumission_tete,
+					__ATOMIC_ACQUIRE);
+				l_retour = syscall(__NR_io_uring_enter, l_anneau.descripteur,
+					l_a_soumettre, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+			} while (l_retour < 0 && errno == EINTR);
+			if (l_retour < 0 && errno != EAGAIN && errno != EBUSY) {
+				abandonner_anneau_lot_arbre_binaire(a_lot, l_prets, l_debut,
+					l_nombre_prets);
+				l_termines = a_lot->nombre;
+			} else {
+				l_tete = *l_anneau.completion_tete;
+				while (l_tete != __atomic_load_n(l_anneau.completion_queue,
+						__ATOMIC_ACQUIRE)) {
+					l_completion = &l_anneau.completions[l_tete &
+						*l_anneau.completion_masque];
+					l_fichier = &a_lot->fichiers[l_completion->user_data];
+					completer_fichier_lot_arbre_binaire(a_lot, l_fichier,
+						l_completion->res);
+					if (l_fichier->etape == ETAPE_TERMINEE) {
+						l_termines = l_termines + 1;
+					} else {
+						l_prets[(l_debut + l_nombre_prets) % a_lot->nombre] =
+							(int)l_completion->user_data;
+						l_nombre_prets = l_nombre_prets + 1;
+					}
+					l_en_cours = l_en_cours - 1;
+					l_tete = l_tete + 1;
+				}
+				__atomic_store_n(l_anneau.completion_tete, l_tete,
+					__ATOMIC_RELEASE);
+			}
+		}
+		free(l_prets);
+		fermer_anneau_arbre_binaire(&l_anneau);
+	}
+	return l_result;
+}
+#endif
+
+/**
+ *  \brief Sauvegarde plusieurs arbres, chacun dans son fichier.
+ *
+ *  \param arbres Les arbres  sauvegarder
+ *  \param noms_fichiers Les noms des fichiers o sauvegarder les 'arbres'
+ *  \param nombre Le nombre d'arbres  sauvegarder
+ *
+ *  \return Le nombre de fichiers qui n'ont pas pu tre sauvegards
+ */
+int sauvegarder_lot_arbre_binaire(arbre_binaire** a_arbres,
+		char** a_noms_fichiers, int a_nombre)
+{
+	int l_erreurs = 0;
+	bool l_termine = false;
+	lot_arbre_binaire l_lot;
+	fichier_lot_arbre_binaire* l_fichier;
+	size_t l_capacite;
+	int l_i;
+	l_lot.nombre = a_nombre;
+	l_lot.ecriture = true;
+	l_lot.fichiers = calloc(a_nombre, sizeof(fichier_lot_arbre_binaire));
+	if (l_lot.fichiers) {
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			l_fichier = &l_lot.fichiers[l_i];
+			l_fichier->arbre = a_arbres[l_i];
+			l_fichier->nom_fichier = a_noms_fichiers[l_i];
+			l_fichier->etape = ETAPE_OUVRIR;
+			l_capacite = 0;
+			l_fichier->taille = serialiser_extensible_arbre_binaire(
+				l_fichier->arbre, (void**)&l_fichier->tampon, &l_capacite);
+			if (l_fichier->taille == 0) {
+				l_fichier->erreur =
+					"Ne peux pas allouer la mmoire pour srialiser l'arbre.";
+				l_fichier->etape = ETAPE_TERMINEE;
+			}
+		}
+#ifdef ARBRE_BINAIRE_IO_URING
+		l_termine = executer_anneau_lot_arbre_binaire(&l_lot);
+#endif
+		if (!l_termine) {
+			executer_fils_lot_arbre_binaire(&l_lot);
+		}
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			l_fichier = &l_lot.fichiers[l_i];
+			if (l_fichier->erreur) {
+				inscrire_erreur_arbre_binaire(a_arbres[l_i],
+					l_fichier->erreur);
+				l_erreurs = l_erreurs + 1;
+			}
+			free(l_fichier->tampon);
+		}
+	} else {
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			sauvegarder_arbre_binaire(a_arbres[l_i], a_noms_fichiers[l_i]);
+			if (a_arbres[l_i]->a_erreur) {
+				l_erreurs = l_erreurs + 1;
+			}
+		}
+	}
+	free(l_lot.fichiers);
+	return l_erreurs;
+}
+
+/**
+ *  \brief Crer plusieurs arbres, chacun depuis son fichier.
+ *
+ *  \param arbres Reoit les arbres chargs
+ *  \param noms_fichiers Les noms des fichiers contenant les arbres
+ *  \param nombre Le nombre d'arbres  charger
+ *
+ *  \return Le nombre d'arbres qui n'ont pas pu tre chargs
+ */
+int charger_lot_arbre_binaire(arbre_binaire** a_arbres,
+		char** a_noms_fichiers, int a_nombre)
+{
+	int l_erreurs = 0;
+	bool l_termine = false;
+	lot_arbre_binaire l_lot;
+	int l_i;
+	l_lot.nombre = a_nombre;
+	l_lot.ecriture = false;
+	l_lot.fichiers = calloc(a_nombre, sizeof(fichier_lot_arbre_binaire));
+#ifdef ARBRE_BINAIRE_IO_URING
+	if (l_lot.fichiers) {
+		fichier_lot_arbre_binaire* l_fichier;
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			l_fichier = &l_lot.fichiers[l_i];
+			l_fichier->nom_fichier = a_noms_fichiers[l_i];
+			l_fichier->etape = ETAPE_OUVRIR;
+			l_fichier->taille = LOT_TAMPON;
+			l_fichier->tampon = malloc(l_fichier->taille);
+			if (!l_fichier->tampon) {
+				l_fichier->erreur = "Ne peux pas allouer la mmoire.";
+				l_fichier->etape = ETAPE_TERMINEE;
+			}
+		}
+		l_termine = executer_anneau_lot_arbre_binaire(&l_lot);
+		for (l_i = 0; l_i < a_nombre && l_termine; l_i = l_i + 1) {
+			l_fichier = &l_lot.fichiers[l_i];
+			if (l_fichier->erreur) {
+				l_fichier->arbre = creer_arbre_binaire(0);
+			} else {
+				l_fichier->arbre = deserialiser_arbre_binaire(
+					l_fichier->tampon, l_fichier->fait);
+			}
+		}
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			free(l_lot.fichiers[l_i].tampon);
+		}
+	}
+#endif
+	if (!l_termine) {
+		for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+			if (l_lot.fichiers) {
+				l_lot.fichiers[l_i].nom_fichier = a_noms_fichiers[l_i];
+				l_lot.fichiers[l_i].etape = ETAPE_OUVRIR;
+				l_lot.fichiers[l_i].tampon = NULL;
+				l_lot.fichiers[l_i].arbre = NULL;
+				l_lot.fichiers[l_i].erreur = NULL;
+			} else {
+				a_arbres[l_i] = charger_arbre_binaire(a_noms_fichiers[l_i]);
+			}
+		}
+		if (l_lot.fichiers) {
+			executer_fils_lot_arbre_binaire(&l_lot);
+		}
+	}
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		if (l_lot.fichiers) {
+			a_arbres[l_i] = l_lot.fichiers[l_i].arbre;
+			if (!a_arbres[l_i]) {
+				a_arbres[l_i] = creer_arbre_binaire(0);
+				l_lot.fichiers[l_i].erreur = "Ne peux pas allouer la mmoire.";
+			}
+			if (a_arbres[l_i] && l_lot.fichiers[l_i].erreur) {
+				inscrire_erreur_arbre_binaire(a_arbres[l_i],
+					l_lot.fichiers[l_i].erreur);
+			}
+		}
+		if (!a_arbres[l_i] || a_arbres[l_i]->a_erreur) {
+			l_erreurs = l_erreurs + 1;
+		}
+	}
+	free(l_lot.fichiers);
+	return l_erreurs;
+}
+
+/**
+ *  \brief Renvoie le logarithme en base 2 arrondi vers le bas de 'valeur'.
+ *
+ *  \param valeur Un nombre plus grand que 0
+ *
+ *  \return Le logarithme de la 'valeur'
+ */
+int logarithme_arbre_binaire(taille_arbre_binaire a_valeur)
+{
+	return 63 - __builtin_clzll((unsigned long long)a_valeur);
+}
+
+/**
+ *  \brief Renvoie la position d'un 'noeud' dans l'index des 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param noeud Le noeud  rechercher
+ *
+ *  \return La position du 'noeud' ou de la case vide o il serait plac
+ */
+size_t position_index_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, arbre_binaire* a_noeud)
+{
+	size_t l_masque = a_ancetres->capacite_index - 1;
+	size_t l_position = (size_t)melanger_hachage_arbre_binaire(
+		(uint64_t)(uintptr_t)a_noeud) & l_masque;
+	while (a_ancetres->index[l_position] &&
+			a_ancetres->index[l_position] != a_noeud) {
+		l_position = (l_position + 1) & l_masque;
+	}
+	return l_position;
+}
+
+/**
+ *  \brief Numrote les noeuds de l''arbre' dans l'ordre prfixe.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire  remplir
+ *  \param arbre L'arbre_binaire  numroter
+ *
+ *  \return true si la numrotation a russi, false si la mmoire a manqu.
+ */
+bool numeroter_ancetres_arbre_binaire(ancetres_arbre_binaire* a_ancetres,
+		arbre_binaire* a_arbre)
+{
+	bool l_result = true;
+	taille_arbre_binaire l_capacite = 64;
+	taille_arbre_binaire l_capacite_noeuds = 64;
+	taille_arbre_binaire l_taille = 1;
+	parcours_ancetres_arbre_binaire* l_pile =
+		malloc(l_capacite * sizeof(parcours_ancetres_arbre_binaire));
+	parcours_ancetres_arbre_binaire l_courant;
+	void* l_nouveau;
+	a_ancetres->nombre = 0;
+	a_ancetres->noeuds = malloc(l_capacite_noeuds * sizeof(arbre_binaire*));
+	a_ancetres->profondeurs = malloc(l_capacite_noeuds *
+		sizeof(taille_arbre_binaire));
+	a_ancetres->parents = malloc(l_capacite_noeuds *
+		sizeof(taille_arbre_binaire));
+	if (l_pile && a_ancetres->noeuds && a_ancetres->profondeurs &&
+			a_ancetres->parents) {
+		l_pile[0].noeud = a_arbre;
+		l_pile[0].parent = -1;
+		l_pile[0].profondeur = 0;
+	} else {
+		l_taille = 0;
+		l_result = false;
+	}
+	while (l_taille > 0) {
+		l_taille = l_taille - 1;
+		l_courant = l_pile[l_taille];
+		if (a_ancetres->nombre == l_capacite_noeuds) {
+			l_capacite_noeuds = l_capacite_noeuds * 2;
+			l_nouveau = realloc(a_ancetres->noeuds,
+				l_capacite_noeuds * sizeof(arbre_binaire*));
+			if (l_nouveau) {
+				a_ancetres->noeuds = l_nouveau;
+				l_nouveau = realloc(a_ancetres->profondeurs,
+					l_capacite_noeuds * sizeof(taille_arbre_binaire));
+			}
+			if (l_nouveau) {
+				a_ancetres->profondeurs = l_nouveau;
+				l_nouveau = realloc(a_ancetres->parents,
+					l_capacite_noeuds * sizeof(taille_arbre_binaire));
+			}
+			if (l_nouveau) {
+				a_ancetres->parents = l_nouveau;
+			} else {
+				l_result = false;
+			}
+		}
+		if (l_result && l_taille + 2 > l_capacite) {
+			l_nouveau = realloc(l_pile,
+				l_capacite * 2 * sizeof(parcours_ancetres_arbre_binaire));
+			if (l_nouveau) {
+				l_pile = l_nouveau;
+				l_capacite = l_capacite * 2;
+			} else {
+				l_result = false;
+			}
+		}
+		if (l_result) {
+			a_ancetres->noeuds[a_ancetres->nombre] = l_courant.noeud;
+			a_ancetres->profondeurs[a_ancetres->nombre] = l_courant.profondeur;
+			a_ancetres->parents[a_ancetres->nombre] = l_courant.parent;
+			if (l_courant.noeud->second_enfant) {
+				l_pile[l_taille].noeud = l_courant.noeud->second_enfant;
+				l_pile[l_taille].parent = a_ancetres->nombre;
+				l_pile[l_taille].profondeur = l_courant.profondeur + 1;
+				l_taille = l_taille + 1;
+			}
+			if (l_courant.noeud->premier_enfant) {
+				l_pile[l_taille].noeud = l_courant.noeud->premier_enfant;
+				l_pile[l_taille].parent = a_ancetres->nombre;
+				l_pile[l_taille].profondeur = l_courant.profondeur + 1;
+				l_taille = l_taille + 1;
+			}
+			a_ancetres->nombre = a_ancetres->nombre + 1;
+		} else {
+			l_taille = 0;
+		}
+	}
+	free(l_pile);
+	return l_result;
+}
+
+/**
+ *  \brief Renvoie celui des noeuds 'gauche' et 'droite' qui est le moins
+ *         profond, 'gauche' en cas d'galit.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param gauche Le numro du premier noeud
+ *  \param droite Le numro du second noeud
+ *
+ *  \return Le numro du noeud le moins profond
+ */
+taille_arbre_binaire plus_haut_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, taille_arbre_binaire a_gauche,
+		taille_arbre_binaire a_droite)
+{
+	taille_arbre_binaire l_result = a_gauche;
+	if (a_ancetres->profondeurs[a_droite] <
+			a_ancetres->profondeurs[a_gauche]) {
+		l_result = a_droite;
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Renvoie le noeud le moins profond entre 'debut' et 'fin', qui
+ *         doivent appartenir au mme bloc.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param debut Le numro du premier noeud de l'intervalle
+ *  \param fin Le numro du dernier noeud de l'intervalle
+ *
+ *  \return Le numro du noeud le moins profond
+ */
+taille_arbre_binaire minimum_bloc_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, taille_arbre_binaire a_debut,
+		taille_arbre_binaire a_fin)
+{
+	uint64_t l_masque = a_ancetres->masques[a_fin] &
+		(~(uint64_t)0 << (a_debut % BLOC_ANCETRES));
+	return a_debut - a_debut % BLOC_ANCETRES +
+		__builtin_ctzll((unsigned long long)l_masque);
+}
+
+/**
+ *  \brief Renvoie le noeud le moins profond entre 'debut' et 'fin'.
+ *
+ *  Les parties de l'intervalle qui dbordent dans le bloc de 'debut' et dans
+ *  celui de 'fin' sont lues dans les masques, les blocs entiers entre les
+ *  deux dans la table creuse.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param debut Le numro du premier noeud de l'intervalle
+ *  \param fin Le numro du dernier noeud de l'intervalle
+ *
+ *  \return Le numro du noeud le moins profond
+ */
+taille_arbre_binaire minimum_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, taille_arbre_binaire a_debut,
+		taille_arbre_binaire a_fin)
+{
+	taille_arbre_binaire l_result;
+	taille_arbre_binaire l_bloc_debut = a_debut / BLOC_ANCETRES;
+	taille_arbre_binaire l_bloc_fin = a_fin / BLOC_ANCETRES;
+	taille_arbre_binaire* l_niveau;
+	int l_k;
+	if (l_bloc_debut == l_bloc_fin) {
+		l_result = minimum_bloc_ancetres_arbre_binaire(a_ancetres, a_debut,
+			a_fin);
+	} else {
+		l_result = plus_haut_ancetres_arbre_binaire(a_ancetres,
+			minimum_bloc_ancetres_arbre_binaire(a_ancetres, a_debut,
+			l_bloc_debut * BLOC_ANCETRES + BLOC_ANCETRES - 1),
+			minimum_bloc_ancetres_arbre_binaire(a_ancetres,
+			l_bloc_fin * BLOC_ANCETRES, a_fin));
+		if (l_bloc_debut + 1 < l_bloc_fin) {
+			l_k = logarithme_arbre_binaire(l_bloc_fin - l_bloc_debut - 1);
+			l_niveau = a_ancetres->table +
+				(size_t)l_k * a_ancetres->nombre_blocs;
+			l_result = plus_haut_ancetres_arbre_binaire(a_ancetres,
+				l_result, l_niveau[l_bloc_debut + 1]);
+			l_result = plus_haut_ancetres_arbre_binaire(a_ancetres,
+				l_result, l_niveau[l_bloc_fin -
+				((taille_arbre_binaire)1 << l_k)]);
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Calcule les masques de chaque bloc des 'ancetres' et place le
+ *         noeud le moins profond de chaque bloc au premier niveau de la
+ *         table creuse.
+ *
+ *  Les noeuds du bloc sont parcourus en conservant dans un masque la pile
+ *  des noeuds strictement moins profonds que tous ceux qui les suivent.
+ *  Chaque noeud n'est retir de la pile qu'une fois.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire  remplir
+ */
+void masquer_ancetres_arbre_binaire(ancetres_arbre_binaire* a_ancetres)
+{
+	taille_arbre_binaire l_i;
+	taille_arbre_binaire l_debut = 0;
+	uint64_t l_pile = 0;
+	int l_sommet;
+	for (l_i = 0; l_i < a_ancetres->nombre; l_i = l_i + 1) {
+		if (l_i % BLOC_ANCETRES == 0) {
+			l_debut = l_i;
+			l_pile = 0;
+		}
+		while (l_pile != 0) {
+			l_sommet = 63 - __builtin_clzll((unsigned long long)l_pile);
+			if (a_ancetres->profondeurs[l_debut + l_sommet] >=
+					a_ancetres->profondeurs[l_i]) {
+				l_pile = l_pile & ~((uint64_t)1 << l_sommet);
+			} else {
+				break;
+			}
+		}
+		l_pile = l_pile | ((uint64_t)1 << (l_i - l_debut));
+		a_ancetres->masques[l_i] = l_pile;
+		if (l_i % BLOC_ANCETRES == BLOC_ANCETRES - 1 ||
+				l_i == a_ancetres->nombre - 1) {
+			a_ancetres->table[l_i / BLOC_ANCETRES] = l_debut +
+				__builtin_ctzll((unsigned long long)l_pile);
+		}
+	}
+}
+
+/**
+ *  \brief Calcule la fin des sous-arbres, les masques, la table creuse et
+ *         l'index des 'ancetres' dj numrots.
+ *
+ *  La table creuse ne porte que sur les n / BLOC_ANCETRES blocs et compte
+ *  donc moins d'une entre par noeud: le calcul se fait en temps et en
+ *  mmoire proportionnels au nombre de noeuds.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire  remplir
+ *
+ *  \return true si le calcul a russi, false si la mmoire a manqu.
+ */
+bool indexer_ancetres_arbre_binaire(ancetres_arbre_binaire* a_ancetres)
+{
+	bool l_result = false;
+	taille_arbre_binaire l_nombre = a_ancetres->nombre;
+	taille_arbre_binaire l_blocs = (l_nombre + BLOC_ANCETRES - 1) /
+		BLOC_ANCETRES;
+	int l_niveaux = logarithme_arbre_binaire(l_blocs) + 1;
+	taille_arbre_binaire* l_niveau;
+	taille_arbre_binaire* l_precedent;
+	int l_k;
+	taille_arbre_binaire l_i;
+	a_ancetres->nombre_blocs = l_blocs;
+	a_ancetres->sorties = malloc(l_nombre * sizeof(taille_arbre_binaire));
+	a_ancetres->masques = malloc(l_nombre * sizeof(uint64_t));
+	a_ancetres->table = malloc((size_t)l_niveaux * l_blocs *
+		sizeof(taille_arbre_binaire));
+	a_ancetres->capacite_index = 2;
+	while (a_ancetres->capacite_index < (size_t)l_nombre * 2) {
+		a_ancetres->capacite_index = a_ancetres->capacite_index * 2;
+	}
+	a_ancetres->index = calloc(a_ancetres->capacite_index,
+		sizeof(arbre_binaire*));
+	a_ancetres->numeros_index = malloc(a_ancetres->capacite_index *
+		sizeof(taille_arbre_binaire));
+	if (a_ancetres->sorties && a_ancetres->masques && a_ancetres->table &&
+			a_ancetres->index && a_ancetres->numeros_index) {
+		for (l_i = 0; l_i < l_nombre; l_i = l_i + 1) {
+			a_ancetres->sorties[l_i] = l_i;
+		}
+		for (l_i = l_nombre - 1; l_i > 0; l_i = l_i - 1) {
+			if (a_ancetres->sorties[l_i] >
+					a_ancetres->sorties[a_ancetres->parents[l_i]]) {
+				a_ancetres->sorties[a_ancetres->parents[l_i]] =
+					a_ancetres->sorties[l_i];
+			}
+		}
+		masquer_ancetres_arbre_binaire(a_ancetres);
+		for (l_k = 1; l_k < l_niveaux; l_k = l_k + 1) {
+			l_niveau = a_ancetres->table + (size_t)l_k * l_blocs;
+			l_precedent = l_niveau - l_blocs;
+			for (l_i = 0; l_i + ((taille_arbre_binaire)1 << l_k) <= l_blocs;
+					l_i = l_i + 1) {
+				l_niveau[l_i] = plus_haut_ancetres_arbre_binaire(a_ancetres,
+					l_precedent[l_i], l_precedent[l_i +
+					((taille_arbre_binaire)1 << (l_k - 1))]);
+			}
+		}
+		for (l_i = 0; l_i < l_nombre; l_i = l_i + 1) {
+			size_t l_position = position_index_ancetres_arbre_binaire(
+				a_ancetres, a_ancetres->noeuds[l_i]);
+			if (!a_ancetres->index[l_position]) {
+				a_ancetres->index[l_position] = a_ancetres->noeuds[l_i];
+				a_ancetres->numeros_index[l_position] = l_i;
+			}
+		}
+		l_result = true;
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Effectue la dsallocation d'un ancetres_arbre_binaire.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire  dsallouer
+ */
+void detruire_ancetres_arbre_binaire(ancetres_arbre_binaire* a_ancetres)
+{
+	free(a_ancetres->noeuds);
+	free(a_ancetres->profondeurs);
+	free(a_ancetres->parents);
+	free(a_ancetres->sorties);
+	free(a_ancetres->masques);
+	free(a_ancetres->table);
+	free(a_ancetres->index);
+	free(a_ancetres->numeros_index);
+	free(a_ancetres);
+}
+
+/**
+ *  \brief Prpare les requtes d'anctres sur l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire  prparer
+ *
+ *  \return L'ancetres_arbre_binaire ou NULL si la mmoire a manqu
+ *
+ *  \note 'arbre' ne doit pas tre NULL
+ */
+ancetres_arbre_binaire* creer_ancetres_arbre_binaire(arbre_binaire* a_arbre)
+{
+	ancetres_arbre_binaire* l_result =
+		calloc(1, sizeof(ancetres_arbre_binaire));
+	if (l_result) {
+		if (!materialiser_tout_arbre_binaire(a_arbre) ||
+				!numeroter_ancetres_arbre_binaire(l_result, a_arbre) ||
+				!indexer_ancetres_arbre_binaire(l_result)) {
+			detruire_ancetres_arbre_binaire(l_result);
+			l_result = NULL;
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Renvoie le nombre de noeuds numrots dans les 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *
+ *  \return Le nombre de noeuds
+ *
+ *  \note 'ancetres' ne doit pas tre NULL
+ */
+taille_arbre_binaire nombre_noeuds_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres)
+{
+	return a_ancetres->nombre;
+}
+
+/**
+ *  \brief Renvoie le numro d'un 'noeud' dans les 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param noeud Le noeud  rechercher
+ *
+ *  \return Le numro du 'noeud' ou -1 s'il n'en fait pas partie
+ *
+ *  \note 'ancetres' ne doit pas tre NULL
+ */
+taille_arbre_binaire numero_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, arbre_binaire* a_noeud)
+{
+	taille_arbre_binaire l_numero = -1;
+	size_t l_position = position_index_ancetres_arbre_binaire(a_ancetres,
+		a_noeud);
+	if (a_ancetres->index[l_position]) {
+		l_numero = a_ancetres->numeros_index[l_position];
+	}
+	return l_numero;
+}
+
+/**
+ *  \brief Renvoie le noeud portant le 'numero' dans les 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numero Le numro du noeud
+ *
+ *  \return Le noeud
+ *
+ *  \note 'numero' doit tre entre 0 et le nombre de noeuds
+ */
+arbre_binaire* noeud_ancetres_arbre_binaire(ancetres_arbre_binaire* a_ancetres,
+		taille_arbre_binaire a_numero)
+{
+	return a_ancetres->noeuds[a_numero];
+}
+
+/**
+ *  \brief Renvoie la profondeur du noeud 'numero'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numero Le numro du noeud
+ *
+ *  \return La profondeur du noeud, 0 pour la racine
+ *
+ *  \note 'numero' doit tre entre 0 et le nombre de noeuds
+ */
+taille_arbre_binaire profondeur_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, taille_arbre_binaire a_numero)
+{
+	return a_ancetres->profondeurs[a_numero];
+}
+
+/**
+ *  \brief Indique si le noeud 'ancetre' est un anctre du noeud
+ *         'descendant'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param ancetre Le numro de l'anctre
+ *  \param descendant Le numro du descendant
+ *
+ *  \return true si 'ancetre' est 'descendant' ou un de ses anctres.
+ *
+ *  \note 'ancetre' et 'descendant' doivent tre entre 0 et le nombre de
+ *        noeuds
+ */
+bool est_ancetre_arbre_binaire(ancetres_arbre_binaire* a_ancetres,
+		taille_arbre_binaire a_ancetre, taille_arbre_binaire a_descendant)
+{
+	return a_ancetre <= a_descendant &&
+		a_descendant <= a_ancetres->sorties[a_ancetre];
+}
+
+/**
+ *  \brief Renvoie le plus proche anctre commun de deux noeuds.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numero1 Le numro du premier noeud
+ *  \param numero2 Le numro du second noeud
+ *
+ *  \return Le numro du plus proche anctre commun
+ *
+ *  \note 'numero1' et 'numero2' doivent tre entre 0 et le nombre de noeuds
+ */
+taille_arbre_binaire ancetre_commun_arbre_binaire(
+		ancetres_arbre_binaire* a_ancetres, taille_arbre_binaire a_numero1,
+		taille_arbre_binaire a_numero2)
+{
+	taille_arbre_binaire l_result = a_numero1;
+	if (a_numero1 < a_numero2) {
+		l_result = a_ancetres->parents[minimum_ancetres_arbre_binaire(
+			a_ancetres, a_numero1 + 1, a_numero2)];
+	} else if (a_numero2 < a_numero1) {
+		l_result = a_ancetres->parents[minimum_ancetres_arbre_binaire(
+			a_ancetres, a_numero2 + 1, a_numero1)];
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Renvoie le plus proche anctre commun de plusieurs paires de
+ *         noeuds.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numeros1 Les numros des premiers noeuds de chaque paire
+ *  \param numeros2 Les numros des seconds noeuds de chaque paire
+ *  \param resultats Reoit le numro de l'anctre commun de chaque paire
+ *  \param nombre Le nombre de paires
+ *
+ *  \note 'ancetres' ne doit pas tre NULL
+ */
+void ancetres_communs_lot_arbre_binaire(ancetres_arbre_binaire* a_ancetres,
+		const taille_arbre_binaire* a_numeros1,
+		const taille_arbre_binaire* a_numeros2,
+		taille_arbre_binaire* a_resultats, taille_arbre_binaire a_nombre)
+{
+	taille_arbre_binaire l_i;
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		a_resultats[l_i] = ancetre_commun_arbre_binaire(a_ancetres,
+			a_numeros1[l_i], a_numeros2[l_i]);
+	}
+}
+
+/**
+ *  \brief Retire l'enfant plac dans l'emplacement 'enfant' de l''arbre'
+ *         sans le dsallouer.
+ *
+ *  \param arbre L'arbre_binaire qui contient l'enfant
+ *  \param enfant L'emplacement de l'enfant dans l''arbre'
+ *  \param erreur Le texte de l'erreur si l'emplacement est vide
+ *
+ *  \return L'enfant dtach ou NULL si l'emplacement est vide
+ *
+ *  \note 'arbre' et 'enfant' ne doivent pas tre NULL
+ */
+arbre_binaire* detacher_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire** a_enfant, const char* a_erreur)
+{
+	arbre_binaire* l_result = NULL;
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (!*a_enfant) {
+			inscrire_erreur_arbre_binaire(a_arbre, a_erreur);
+		} else {
+			*a_enfant = enfant_unique_arbre_binaire(NULL, *a_enfant);
+			if ((*a_enfant)->partage) {
+				inscrire_erreur_arbre_binaire(a_arbre,
+					"Ne peux pas allouer la mmoire.");
+			} else {
+				l_result = *a_enfant;
+				*a_enfant = NULL;
+				invalider_hachage_arbre_binaire(a_arbre);
+			}
+		}
+	}
+	return l_result;
+}
+
+/**
+ *  \brief Retire le premier enfant de l''arbre' sans le dsallouer.
+ *
+ *  \param arbre L'arbre_binaire  dtacher le premier enfant
+ *
+ *  \return Le premier enfant dtach ou NULL s'il n'existe pas
  *
  *  \note 'arbre' ne doit pas tre NULL
  */
-void sauvegarder_arbre_binaire(arbre_binaire* a_arbre, char* a_nom_fichier)
+arbre_binaire* detacher_premier_enfant_arbre_binaire(arbre_binaire* a_arbre)
 {
-	FILE* l_fichier;
-	retirer_erreur_arbre_binaire(a_arbre);
-	l_fichier = fopen(a_nom_fichier, "wb");
-	if (l_fichier) {
-		ecrire_arbre_binaire(a_arbre, l_fichier);
-		fclose(l_fichier);
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre, 
-			"Ne peux pas ouvrir le fichier en criture.");
-	}
+	return detacher_enfant_arbre_binaire(a_arbre, &a_arbre->premier_enfant,
+		"Aucun premier enfant  dtacher.");
 }
- 
+
 /**
- *  \brief Renvoie le nombre d'lments de l''arbre'
+ *  \brief Retire le second enfant de l''arbre' sans le dsallouer.
  *
- *  \param arbre L'arbre_binaire
+ *  \param arbre L'arbre_binaire  dtacher le second enfant
  *
- *  \return Le nombre d'lments dans l''arbre'
+ *  \return Le second enfant dtach ou NULL s'il n'existe pas
  *
  *  \note 'arbre' ne doit pas tre NULL
  */
-int nombre_elements_arbre_binaire(arbre_binaire* a_arbre)
+arbre_binaire* detacher_second_enfant_arbre_binaire(arbre_binaire* a_arbre)
 {
-	int l_nombre_elements = 1;
-	if (a_arbre->premier_enfant) {
-		l_nombre_elements = l_nombre_elements + 
-			nombre_elements_arbre_binaire(a_arbre->premier_enfant);
-	}
-	if (a_arbre->second_enfant) {
-		l_nombre_elements = l_nombre_elements + 
-			nombre_elements_arbre_binaire(a_arbre->second_enfant);
-	}
-	return l_nombre_elements;
+	return detacher_enfant_arbre_binaire(a_arbre, &a_arbre->second_enfant,
+		"Aucun second enfant  dtacher.");
 }
 
 /**
- *  \brief Renvoie le nombre de feuilles de l''arbre'
+ *  \brief Place le 'sous_arbre' dans l'emplacement 'enfant' de l''arbre'.
  *
- *  \param arbre L'arbre_binaire
+ *  Le 'sous_arbre' est refus s'il est partag ou s'il a un parent. Si
+ *  'verifier' est vrai, il est aussi refus s'il est un anctre de
+ *  l''arbre', ce qui demande de remonter les parents de l''arbre'.
  *
- *  \return Le nombre de feuilles dans l''arbre'
+ *  \param arbre L'arbre_binaire qui reoit le 'sous_arbre'
+ *  \param enfant L'emplacement de l'enfant dans l''arbre'
+ *  \param sous_arbre L'arbre_binaire  greffer
+ *  \param erreur Le texte de l'erreur si l'emplacement est occup
+ *  \param verifier Si vrai, vrifie que le 'sous_arbre' ne contient pas
+ *                  l''arbre'
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \note 'arbre', 'enfant' et 'sous_arbre' ne doivent pas tre NULL
  */
-int nombre_feuilles_arbre_binaire(arbre_binaire* a_arbre)
+void greffer_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire** a_enfant, arbre_binaire* a_sous_arbre,
+		const char* a_erreur, bool a_verifier)
 {
-	int l_nombre_feuilles = 0;
-	if (!a_arbre->premier_enfant && !a_arbre->second_enfant) {
-		l_nombre_feuilles = 1;
-	} else {
-		if (a_arbre->premier_enfant) {
-			l_nombre_feuilles = l_nombre_feuilles + 
-				nombre_feuilles_arbre_binaire(a_arbre->premier_enfant);
+	arbre_binaire* l_ancetre = NULL;
+	if (verifier_modifiable_arbre_binaire(a_arbre)) {
+		materialiser_arbre_binaire(a_arbre);
+		if (a_verifier) {
+			l_ancetre = a_arbre;
+			while (l_ancetre && l_ancetre != a_sous_arbre) {
+				l_ancetre = l_ancetre->parent;
+			}
 		}
-		if (a_arbre->second_enfant) {
-			l_nombre_feuilles = l_nombre_feuilles + 
-				nombre_feuilles_arbre_binaire(a_arbre->second_enfant);
+		if (*a_enfant) {
+			inscrire_erreur_arbre_binaire(a_arbre, a_erreur);
+		} else if (a_sous_arbre->partage ||
+				atomic_load(&a_sous_arbre->references) > 1) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Le sous-arbre  greffer est partag.");
+		} else if (l_ancetre == a_sous_arbre) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Le sous-arbre  greffer contient l'arbre.");
+		} else if (a_sous_arbre->parent) {
+			inscrire_erreur_arbre_binaire(a_arbre,
+				"Le sous-arbre  greffer a dj un parent.");
+		} else {
+			a_sous_arbre->parent = a_arbre;
+			*a_enfant = a_sous_arbre;
+			invalider_hachage_arbre_binaire(a_arbre);
 		}
 	}
-	return l_nombre_feuilles;
 }
 
 /**
- *  \brief Renvoie la hauteur de l''arbre'
+ *  \brief Place le 'sous_arbre' comme premier enfant de l''arbre'.
  *
- *  \param arbre L'arbre_binaire
+ *  \param arbre L'arbre_binaire qui reoit le premier enfant
+ *  \param sous_arbre L'arbre_binaire  greffer
  *
- *  \return La hauteur de l''arbre'
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas tre NULL
+ */
+void greffer_premier_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_sous_arbre)
+{
+	greffer_enfant_arbre_binaire(a_arbre, &a_arbre->premier_enfant,
+		a_sous_arbre, "Premier enfant dja existant.", false);
+}
+
+/**
+ *  \brief Place le 'sous_arbre' comme premier enfant de l''arbre' aprs avoir
+ *         vrifi qu'il ne contient pas l''arbre'.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param arbre L'arbre_binaire qui reoit le premier enfant
+ *  \param sous_arbre L'arbre_binaire  greffer
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas tre NULL
  */
-int hauteur_arbre_binaire(arbre_binaire* a_arbre)
+void greffer_premier_enfant_verifie_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_sous_arbre)
 {
-	int l_hauteur = 1;
-	if (a_arbre->premier_enfant || a_arbre->second_enfant) {
-		int l_hauteur_premier_enfant;
-		int l_hauteur_second_enfant;
-		if (a_arbre->premier_enfant) {
-			l_hauteur_premier_enfant = 
-				hauteur_arbre_binaire(a_arbre->premier_enfant);
-		} else {
-			l_hauteur_premier_enfant = 0;
-		}
-		if (a_arbre->second_enfant) {
-			l_hauteur_second_enfant = 
-				hauteur_arbre_binaire(a_arbre->second_enfant);
-		} else {
-			l_hauteur_second_enfant = 0;
-		}
-		if (l_hauteur_premier_enfant >= l_hauteur_second_enfant) {
-			l_hauteur = l_hauteur + l_hauteur_premier_enfant;
-		} else {
-			l_hauteur = l_hauteur + l_hauteur_second_enfant;
-		}
-	}
-	return l_hauteur;
+	greffer_enfant_arbre_binaire(a_arbre, &a_arbre->premier_enfant,
+		a_sous_arbre, "Premier enfant dja existant.", true);
 }
 
 /**
- *  \brief Renvoie l'lment contenu dans la racine de l''arbre'
+ *  \brief Place le 'sous_arbre' comme second enfant de l''arbre'.
  *
- *  \param arbre L'arbre_binaire
+ *  \param arbre L'arbre_binaire qui reoit le second enfant
+ *  \param sous_arbre L'arbre_binaire  greffer
  *
- *  \return La valeur de l'lment contenu dans la racine de l''arbre'
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas tre NULL
+ */
+void greffer_second_enfant_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_sous_arbre)
+{
+	greffer_enfant_arbre_binaire(a_arbre, &a_arbre->second_enfant,
+		a_sous_arbre, "Second enfant dja existant.", false);
+}
+
+/**
+ *  \brief Place le 'sous_arbre' comme second enfant de l''arbre' aprs avoir
+ *         vrifi qu'il ne contient pas l''arbre'.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param arbre L'arbre_binaire qui reoit le second enfant
+ *  \param sous_arbre L'arbre_binaire  greffer
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas tre NULL
  */
-int element_arbre_binaire(arbre_binaire* a_arbre)
+void greffer_second_enfant_verifie_arbre_binaire(arbre_binaire* a_arbre,
+		arbre_binaire* a_sous_arbre)
 {
-	return a_arbre->valeur;
+	greffer_enfant_arbre_binaire(a_arbre, &a_arbre->second_enfant,
+		a_sous_arbre, "Second enfant dja existant.", true);
 }
 
 /**
- *  \brief Modifie l'lment contenu dans la racine de l''arbre'
+ *  \brief Applique le 'noyau'  un bloc de valeurs et replace dans les
+ *         'noeuds' les valeurs qui ont chang.
  *
- *  \param arbre L'arbre_binaire
- *  \param valeur La valeur  mettre dans la racine de l''arbre'
+ *  Si 'modifier' est vrai, l'erreur de chacun des 'noeuds' est retire.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs des 'noeuds'
+ *  \param noeuds Les noeuds d'o proviennent les 'valeurs' ou NULL si
+ *                'modifier' est faux
+ *  \param nombre Le nombre de valeurs du bloc
+ *  \param modifier Vrai si le 'noyau' modifie les valeurs
+ *  \param noyau Le traitement  appliquer au bloc
+ *  \param donnees Les paramtres passs au 'noyau'
  */
-void modifier_element_arbre_binaire(arbre_binaire* a_arbre, int a_valeur)
+void vider_bloc_valeurs_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		arbre_binaire** a_noeuds, size_t a_nombre, bool a_modifier,
+		noyau_arbre_binaire a_noyau, void* a_donnees)
 {
-	a_arbre->valeur = a_valeur;
+	size_t l_i;
+	if (a_nombre > 0) {
+		a_noyau(a_valeurs, a_nombre, a_donnees);
+	}
+	for (l_i = 0; a_modifier && l_i < a_nombre; l_i = l_i + 1) {
+		a_noeuds[l_i]->a_erreur = false;
+		if (a_noeuds[l_i]->valeur != a_valeurs[l_i]) {
+			a_noeuds[l_i]->valeur = a_valeurs[l_i];
+			invalider_hachage_arbre_binaire(a_noeuds[l_i]);
+		}
+	}
 }
 
 /**
- *  \brief Regarde dans l''arbre' s'il contient la 'valeur'.
+ *  \brief Applique le 'noyau'  toutes les valeurs de l''arbre', regroupes
+ *         en blocs contigus de BLOC_VALEURS valeurs.
  *
- *  \param arbre L'arbre_binaire  rechercher la valeur
- *  \param valeur La valeur  rechercher dans l''arbre'
+ *  Si 'modifier' est vrai, les sous-arbres partags sont copis et tous les
+ *  noeuds sont d'abord rassembls dans l'ordre prfixe. Les valeurs ne sont
+ *  modifies qu'ensuite, de sorte qu'un manque de mmoire laisse toutes les
+ *  valeurs de l''arbre' inchanges. Les valeurs changes par le 'noyau' sont
+ *  replaces dans les noeuds.
  *
- *  \return true si la valeur existe dans l''arbre', false sinon.
+ *  \param arbre L'arbre_binaire  parcourir
+ *  \param modifier Vrai si le 'noyau' modifie les valeurs
+ *  \param noyau Le traitement  appliquer  chaque bloc
+ *  \param donnees Les paramtres passs au 'noyau'
+ *
+ *  \return true si le parcours a russi, false si la mmoire a manqu.
  *
  *  \note 'arbre' ne doit pas tre NULL
  */
-bool contient_element_arbre_binaire(arbre_binaire* a_arbre, int a_valeur)
+bool parcourir_valeurs_arbre_binaire(arbre_binaire* a_arbre, bool a_modifier,
+		noyau_arbre_binaire a_noyau, void* a_donnees)
 {
-	bool l_contient = false;
-	if (a_arbre->valeur == a_valeur) {
-		l_contient = true;
+	bool l_result = !a_modifier || materialiser_tout_arbre_binaire(a_arbre);
+	taille_arbre_binaire l_capacite = 64;
+	taille_arbre_binaire l_taille = 1;
+	arbre_binaire** l_pile = malloc(l_capacite * sizeof(arbre_binaire*));
+	size_t l_capacite_ordre = 0;
+	size_t l_taille_ordre = 0;
+	arbre_binaire** l_ordre = NULL;
+	valeur_arbre_binaire l_valeurs[BLOC_VALEURS];
+	size_t l_nombre = 0;
+	size_t l_i;
+	arbre_binaire* l_noeud;
+	void* l_nouveau;
+	if (l_result && l_pile) {
+		l_pile[0] = a_arbre;
 	} else {
-		if (a_arbre->premier_enfant) {
-			if (contient_element_arbre_binaire(a_arbre->premier_enfant,
-			a_valeur)) {
-				l_contient = true;
+		l_taille = 0;
+		l_result = false;
+	}
+	while (l_taille > 0) {
+		l_taille = l_taille - 1;
+		l_noeud = l_pile[l_taille];
+		materialiser_arbre_binaire(l_noeud);
+		if (a_modifier && l_taille_ordre == l_capacite_ordre) {
+			l_nouveau = realloc(l_ordre, (l_capacite_ordre * 2 + 64) *
+				sizeof(arbre_binaire*));
+			if (l_nouveau) {
+				l_ordre = l_nouveau;
+				l_capacite_ordre = l_capacite_ordre * 2 + 64;
+			} else {
+				l_result = false;
 			}
 		}
-		if (a_arbre->second_enfant) {
-			if (contient_element_arbre_binaire(a_arbre->second_enfant,
-			a_valeur)) {
-				l_contient = true;
+		if (l_result && a_modifier) {
+			l_ordre[l_taille_ordre] = l_noeud;
+			l_taille_ordre = l_taille_ordre + 1;
+		} else if (l_result) {
+			l_valeurs[l_nombre] = l_noeud->valeur;
+			l_nombre = l_nombre + 1;
+			if (l_nombre == BLOC_VALEURS) {
+				vider_bloc_valeurs_arbre_binaire(l_valeurs, NULL, l_nombre,
+					false, a_noyau, a_donnees);
+				l_nombre = 0;
+			}
+		}
+		if (l_result && l_taille + 2 > l_capacite) {
+			l_nouveau = realloc(l_pile,
+				l_capacite * 2 * sizeof(arbre_binaire*));
+			if (l_nouveau) {
+				l_pile = l_nouveau;
+				l_capacite = l_capacite * 2;
+			} else {
+				l_result = false;
+			}
+		}
+		if (l_result && a_modifier) {
+			if (l_noeud->premier_enfant) {
+				l_noeud->premier_enfant = enfant_unique_arbre_binaire(l_noeud,
+					l_noeud->premier_enfant);
+				l_result = !l_noeud->premier_enfant->partage;
+			}
+			if (l_result && l_noeud->second_enfant) {
+				l_noeud->second_enfant = enfant_unique_arbre_binaire(l_noeud,
+					l_noeud->second_enfant);
+				l_result = !l_noeud->second_enfant->partage;
+			}
+		}
+		if (!l_result) {
+			l_taille = 0;
+		}
+		if (l_result && l_noeud->second_enfant) {
+			l_pile[l_taille] = l_noeud->second_enfant;
+			l_taille = l_taille + 1;
+		}
+		if (l_result && l_noeud->premier_enfant) {
+			l_pile[l_taille] = l_noeud->premier_enfant;
+			l_taille = l_taille + 1;
+		}
+	}
+	if (l_result && a_modifier) {
+		while (l_nombre < l_taille_ordre) {
+			for (l_i = 0; l_i < BLOC_VALEURS &&
+					l_nombre + l_i < l_taille_ordre; l_i = l_i + 1) {
+				l_valeurs[l_i] = l_ordre[l_nombre + l_i]->valeur;
 			}
+			vider_bloc_valeurs_arbre_binaire(l_valeurs, l_ordre + l_nombre,
+				l_i, true, a_noyau, a_donnees);
+			l_nombre = l_nombre + l_i;
 		}
+	} else if (l_result) {
+		vider_bloc_valeurs_arbre_binaire(l_valeurs, NULL, l_nombre, false,
+			a_noyau, a_donnees);
 	}
-	return l_contient;
+	free(l_ordre);
+	free(l_pile);
+	return l_result;
 }
 
 /**
- *  \brief Retourne le premier enfant de l''arbre' ou 'NULL' si l''arbre' n'a
- *         pas de premier enfant.
+ *  \brief Indique si le processeur supporte les instructions AVX2.
  *
- *  \param arbre L'arbre_binaire  regarder son premier enfant.
- *
- *  \return le premier enfant de l''arbre'
+ *  \return true si les noyaux AVX2 peuvent tre utiliss, false sinon.
+ */
+bool avx2_arbre_binaire(void)
+{
+	bool l_result = false;
+#ifdef ARBRE_BINAIRE_AVX2
+	l_result = __builtin_cpu_supports("avx2");
+#endif
+	return l_result;
+}
+
+/**
+ *  \brief Remplace chaque valeur v par v * 'facteur' + 'decalage', modulo
+ *         la taille de 'valeur_arbre_binaire'.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  transformer
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees L'affine_arbre_binaire  appliquer
  */
-arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* a_arbre)
+void affine_scalaire_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	retirer_erreur_arbre_binaire(a_arbre);
-	arbre_binaire* l_premier_enfant = NULL;
-	if (a_arbre->premier_enfant) {
-		l_premier_enfant = a_arbre->premier_enfant;
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre,
-			"L'arbre n'a aucun premier enfant.");
+	affine_arbre_binaire* l_affine = a_donnees;
+	valeur_non_signee_arbre_binaire l_facteur = l_affine->facteur;
+	valeur_non_signee_arbre_binaire l_decalage = l_affine->decalage;
+	size_t l_i;
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		a_valeurs[l_i] = (valeur_arbre_binaire)(
+			(valeur_non_signee_arbre_binaire)a_valeurs[l_i] * l_facteur +
+			l_decalage);
 	}
-	return l_premier_enfant;
 }
 
 /**
- *  \brief Ajoute un premier enfant d'un 'arbre' et place la valeur dans la
- *         racine de cet enfant.
- *
- *  \param arbre L'arbre_binaire  ajouter un premier enfant
- *  \param valeur La valeur  mettre dans la racine du premier enfant
+ *  \brief Remplace chaque valeur v entre 0 et le nombre d'entres de la
+ *         table par l'entre v de la table.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  remplacer
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees Le remplacement_arbre_binaire  appliquer
  */
-void creer_premier_enfant_arbre_binaire(arbre_binaire* a_arbre, int a_valeur)
+void remplacement_scalaire_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	if (!a_arbre->premier_enfant) {
-		arbre_binaire* l_premier_enfant = creer_arbre_binaire(a_valeur);
-		a_arbre->premier_enfant = l_premier_enfant;
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre, "Premier enfant dja existant.");
+	remplacement_arbre_binaire* l_remplacement = a_donnees;
+	size_t l_i;
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		if (a_valeurs[l_i] >= 0 && a_valeurs[l_i] < l_remplacement->nombre) {
+			a_valeurs[l_i] = l_remplacement->table[a_valeurs[l_i]];
+		}
 	}
 }
 
 /**
- *  \brief Libre le premier enfant d'un 'arbre'.
+ *  \brief Ajoute les valeurs  la somme et met  jour la plus petite et la
+ *         plus grande valeur.
  *
- *  \param arbre L'arbre_binaire  retirer le premier enfant
- *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  rsumer
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees Le resume_arbre_binaire  mettre  jour
  */
-void retirer_premier_enfant_arbre_binaire(arbre_binaire* a_arbre)
+void resume_scalaire_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	if (a_arbre->premier_enfant) {
-		detruire_arbre_binaire(a_arbre->premier_enfant);
-		a_arbre->premier_enfant = NULL;
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre,
-			"Aucun premier enfant  enlever.");
+	resume_arbre_binaire* l_resume = a_donnees;
+	uint64_t l_somme = (uint64_t)l_resume->somme;
+	valeur_arbre_binaire l_minimum = l_resume->minimum;
+	valeur_arbre_binaire l_maximum = l_resume->maximum;
+	size_t l_i;
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		l_somme = l_somme + (uint64_t)a_valeurs[l_i];
+		if (a_valeurs[l_i] < l_minimum) {
+			l_minimum = a_valeurs[l_i];
+		}
+		if (a_valeurs[l_i] > l_maximum) {
+			l_maximum = a_valeurs[l_i];
+		}
 	}
+	l_resume->somme = (int64_t)l_somme;
+	l_resume->minimum = l_minimum;
+	l_resume->maximum = l_maximum;
 }
 
 /**
- *  \brief Retourne le second enfant de l''arbre' ou 'NULL' si l''arbre' n'a
- *         pas de second enfant.
- *
- *  \param arbre L'arbre_binaire  regarder son second enfant.
- *
- *  \return le second enfant de l''arbre'
+ *  \brief Compte les valeurs dans les intervalles d'un histogramme.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  compter
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees L'intervalles_arbre_binaire  mettre  jour
  */
-arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* a_arbre)
+void intervalles_scalaire_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	retirer_erreur_arbre_binaire(a_arbre);
-	arbre_binaire* l_second_enfant = NULL;
-	if (a_arbre->second_enfant) {
-		l_second_enfant = a_arbre->second_enfant;
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre,
-			"L'arbre n'a aucun premier enfant.");
+	intervalles_arbre_binaire* l_intervalles = a_donnees;
+	valeur_non_signee_arbre_binaire l_position;
+	size_t l_i;
+	for (l_i = 0; l_i < a_nombre; l_i = l_i + 1) {
+		if (a_valeurs[l_i] >= l_intervalles->minimum) {
+			l_position = ((valeur_non_signee_arbre_binaire)a_valeurs[l_i] -
+				(valeur_non_signee_arbre_binaire)l_intervalles->minimum) /
+				(valeur_non_signee_arbre_binaire)l_intervalles->largeur;
+			if (l_position < (valeur_non_signee_arbre_binaire)
+					l_intervalles->nombre) {
+				l_intervalles->compteurs[l_position] =
+					l_intervalles->compteurs[l_position] + 1;
+			}
+		}
 	}
-	return l_second_enfant;
 }
 
+#ifdef ARBRE_BINAIRE_AVX2
 /**
- *  \brief Ajoute un second enfant d'un 'arbre' et place la valeur dans la
- *         racine de cet enfant.
+ *  \brief Version AVX2 de 'affine_scalaire_arbre_binaire'.
  *
- *  \param arbre L'arbre_binaire  ajouter un second enfant
- *  \param valeur La valeur  mettre dans la racine du second enfant
+ *  AVX2 n'ayant pas de multiplication sur 64 bits, celle-ci est compose de
+ *  trois multiplications 32 x 32 bits.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  transformer
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees L'affine_arbre_binaire  appliquer
  */
-void creer_second_enfant_arbre_binaire(arbre_binaire* a_arbre, int a_valeur)
+__attribute__((target("avx2")))
+void affine_avx2_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	if (!a_arbre->second_enfant) {
-		arbre_binaire* l_second_enfant = creer_arbre_binaire(a_valeur);
-		a_arbre->second_enfant = l_second_enfant;
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre, "Second enfant dja existant.");
+	affine_arbre_binaire* l_affine = a_donnees;
+	size_t l_largeur = sizeof(__m256i) / sizeof(valeur_arbre_binaire);
+	size_t l_i;
+	__m256i l_valeurs;
+#ifdef ARBRE_BINAIRE_64
+	__m256i l_facteur = _mm256_set1_epi64x(l_affine->facteur);
+	__m256i l_facteur_haut = _mm256_srli_epi64(l_facteur, 32);
+	__m256i l_decalage = _mm256_set1_epi64x(l_affine->decalage);
+	__m256i l_croises;
+#else
+	__m256i l_facteur = _mm256_set1_epi32(l_affine->facteur);
+	__m256i l_decalage = _mm256_set1_epi32(l_affine->decalage);
+#endif
+	for (l_i = 0; l_i + l_largeur <= a_nombre; l_i = l_i + l_largeur) {
+		l_valeurs = _mm256_loadu_si256((__m256i*)(a_valeurs + l_i));
+#ifdef ARBRE_BINAIRE_64
+		l_croises = _mm256_add_epi64(
+			_mm256_mul_epu32(_mm256_srli_epi64(l_valeurs, 32), l_facteur),
+			_mm256_mul_epu32(l_valeurs, l_facteur_haut));
+		l_valeurs = _mm256_add_epi64(_mm256_mul_epu32(l_valeurs, l_facteur),
+			_mm256_slli_epi64(l_croises, 32));
+		l_valeurs = _mm256_add_epi64(l_valeurs, l_decalage);
+#else
+		l_valeurs = _mm256_add_epi32(_mm256_mullo_epi32(l_valeurs, l_facteur),
+			l_decalage);
+#endif
+		_mm256_storeu_si256((__m256i*)(a_valeurs + l_i), l_valeurs);
 	}
+	affine_scalaire_arbre_binaire(a_valeurs + l_i, a_nombre - l_i, a_donnees);
 }
 
 /**
- *  \brief Libre le premier enfant d'un 'arbre'.
+ *  \brief Version AVX2 de 'remplacement_scalaire_arbre_binaire'.
  *
- *  \param arbre L'arbre_binaire  retirer le premier enfant
+ *  Les entres de la table sont lues avec des chargements disperss masqus
+ *  qui conservent les valeurs hors de la table.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  remplacer
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees Le remplacement_arbre_binaire  appliquer
  */
-void retirer_second_enfant_arbre_binaire(arbre_binaire* a_arbre)
+__attribute__((target("avx2")))
+void remplacement_avx2_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	if (a_arbre->second_enfant) {
-		detruire_arbre_binaire(a_arbre->second_enfant);
-		a_arbre->second_enfant = NULL;
-	} else {
-		inscrire_erreur_arbre_binaire(a_arbre,
-			"Aucun second enfant  enlever.");
+	remplacement_arbre_binaire* l_remplacement = a_donnees;
+	size_t l_largeur = sizeof(__m256i) / sizeof(valeur_arbre_binaire);
+	size_t l_i;
+	__m256i l_valeurs;
+	__m256i l_masque;
+#ifdef ARBRE_BINAIRE_64
+	__m256i l_negatif = _mm256_set1_epi64x(-1);
+	__m256i l_nombre = _mm256_set1_epi64x(l_remplacement->nombre);
+#else
+	__m256i l_negatif = _mm256_set1_epi32(-1);
+	__m256i l_nombre = _mm256_set1_epi32(l_remplacement->nombre);
+#endif
+	for (l_i = 0; l_i + l_largeur <= a_nombre; l_i = l_i + l_largeur) {
+		l_valeurs = _mm256_loadu_si256((__m256i*)(a_valeurs + l_i));
+#ifdef ARBRE_BINAIRE_64
+		l_masque = _mm256_and_si256(_mm256_cmpgt_epi64(l_valeurs, l_negatif),
+			_mm256_cmpgt_epi64(l_nombre, l_valeurs));
+		l_valeurs = _mm256_mask_i64gather_epi64(l_valeurs,
+			(const long long*)l_remplacement->table, l_valeurs, l_masque, 8);
+#else
+		l_masque = _mm256_and_si256(_mm256_cmpgt_epi32(l_valeurs, l_negatif),
+			_mm256_cmpgt_epi32(l_nombre, l_valeurs));
+		l_valeurs = _mm256_mask_i32gather_epi32(l_valeurs,
+			l_remplacement->table, l_valeurs, l_masque, 4);
+#endif
+		_mm256_storeu_si256((__m256i*)(a_valeurs + l_i), l_valeurs);
 	}
+	remplacement_scalaire_arbre_binaire(a_valeurs + l_i, a_nombre - l_i,
+		a_donnees);
 }
 
 /**
- *  \brief Indique si l''arbre' contient une erreur
- *
- *  \return true si l''arbre' contient une erreur, false sinon.
+ *  \brief Version AVX2 de 'resume_scalaire_arbre_binaire'.
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \param valeurs Les valeurs  rsumer
+ *  \param nombre Le nombre de 'valeurs'
+ *  \param donnees Le resume_arbre_binaire  mettre  jour
  */
-bool a_erreur_arbre_binaire(arbre_binaire* a_arbre)
+__attribute__((target("avx2")))
+void resume_avx2_arbre_binaire(valeur_arbre_binaire* a_valeurs,
+		size_t a_nombre, void* a_donnees)
 {
-	bool l_erreur = a_arbre->a_erreur;
-	if (!l_erreur) {
-		if (a_arbre->premier_enfant) {
-			if (a_erreur_arbre_binaire(a_arbre->premier_enfant)) {
-				l_erreur = true;
-			}
+	resume_arbre_binaire* l_resume = a_donnees;
+	size_t l_largeur = sizeof(__m256i) / sizeof(valeur_arbre_binaire);
+	size_t l_i;
+	size_t l_j;
+	__m256i l_valeurs;
+	__m256i l_somme = _mm256_setzero_si256();
+	int64_t l_sommes[4];
+	valeur_arbre_binaire l_minimums[sizeof(__m256i) /
+		sizeof(valeur_arbre_binaire)];
+	valeur_arbre_binaire l_maximums[sizeof(__m256i) /
+		sizeof(valeur_arbre_binaire)];
+#ifdef ARBRE_BINAIRE_64
+	__m256i l_minimum = _mm256_set1_epi64x(l_resume->minimum);
+	__m256i l_maximum = _mm256_set1_epi64x(l_resume->maximum);
+#else
+	__m256i l_minimum = _mm256_set1_epi32(l_resume->minimum);
+	__m256i l_maximum = _mm256_set1_epi32(l_resume->maximum);
+#endif
+	for (l_i = 0; l_i + l_largeur <= a_nombre; l_i = l_i + l_largeur) {
+		l_valeurs = _mm256_loadu_si256((__m256i*)(a_valeurs + l_i));
+#ifdef ARBRE_BINAIRE_64
+		l_somme = _mm256_add_epi64(l_somme, l_valeurs);
+		l_minimum = _mm256_blendv_epi8(l_minimum, l_valeurs,
+			_mm256_cmpgt_epi64(l_minimum, l_valeurs));
+		l_maximum = _mm256_blendv_epi8(l_maximum, l_valeurs,
+			_mm256_cmpgt_epi64(l_valeurs, l_maximum));
+#else
+		l_somme = _mm256_add_epi64(l_somme, _mm256_add_epi64(
+			_mm256_cvtepi32_epi64(_mm256_castsi256_si128(l_valeurs)),
+			_mm256_cvtepi32_epi64(_mm256_extracti128_si256(l_valeurs, 1))));
+		l_minimum = _mm256_min_epi32(l_minimum, l_valeurs);
+		l_maximum = _mm256_max_epi32(l_maximum, l_valeurs);
+#endif
+	}
+	_mm256_storeu_si256((__m256i*)l_sommes, l_somme);
+	l_resume->somme = (int64_t)((uint64_t)l_resume->somme +
+		(uint64_t)l_sommes[0] + (uint64_t)l_sommes[1] +
+		(uint64_t)l_sommes[2] + (uint64_t)l_sommes[3]);
+	_mm256_storeu_si256((__m256i*)l_minimums, l_minimum);
+	_mm256_storeu_si256((__m256i*)l_maximums, l_maximum);
+	for (l_j = 0; l_j < l_largeur; l_j = l_j + 1) {
+		if (l_minimums[l_j] < l_resume->minimum) {
+			l_resume->minimum = l_minimums[l_j];
 		}
-		if (!l_erreur) {
-			if (a_arbre->second_enfant) {
-				if (a_erreur_arbre_binaire(a_arbre->second_enfant)) {
-					l_erreur = true;
-				}
-			}
+		if (l_maximums[l_j] > l_resume->maximum) {
+			l_resume->maximum = l_maximums[l_j];
 		}
 	}
-	return l_erreur;
+	resume_scalaire_arbre_binaire(a_valeurs + l_i, a_nombre - l_i, a_donnees);
 }
+#endif
 
 /**
- *  \brief Indique le texte de l'erreur contenue dans 'arbre'
+ *  \brief Remplace chaque valeur v de l''arbre' par
+ *         v * 'facteur' + 'decalage'.
  *
- *  Si 'a_erreur_arbre_binaire' indique que l''arbre' contient une erreur,
- *  retourne l'erreur qu'il contient. Si 'a_erreur_arbre_binaire' est Faux,
- *  Retourne une chaine vide.
- *
- *  \return Le texte de l'erreur.
+ *  \param arbre L'arbre_binaire  transformer
+ *  \param facteur Le facteur multipli  chaque valeur
+ *  \param decalage Le dcalage ajout  chaque valeur
  *
  *  \note 'arbre' ne doit pas tre NULL
  */
-char* erreur_arbre_binaire(arbre_binaire* a_arbre)
+void transformer_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_facteur, valeur_arbre_binaire a_decalage)
 {
-	char* l_erreur = NULL;
-	if (!a_erreur_arbre_binaire(a_arbre)) {
-        strncpy(a_arbre->erreur, "", ERREUR_TAILLE);
-		l_erreur = a_arbre->erreur;
-    } else {
-		if (!a_arbre->a_erreur) {
-			if (a_arbre->premier_enfant) {
-				if (a_erreur_arbre_binaire(a_arbre->premier_enfant)) {
-					l_erreur = erreur_arbre_binaire(a_arbre->premier_enfant);
-				}
-			}
-			if (a_arbre->second_enfant) {
-				if (a_erreur_arbre_binaire(a_arbre->premier_enfant)) {
-					l_erreur = erreur_arbre_binaire(a_arbre->second_enfant);
-				}
-			}
-		} else {
-			l_erreur = a_arbre->erreur;
-		}
+	affine_arbre_binaire l_affine = {a_facteur, a_decalage};
+	noyau_arbre_binaire l_noyau = affine_scalaire_arbre_binaire;
+#ifdef ARBRE_BINAIRE_AVX2
+	if (avx2_arbre_binaire()) {
+		l_noyau = affine_avx2_arbre_binaire;
+	}
+#endif
+	if (verifier_modifiable_arbre_binaire(a_arbre) &&
+			!parcourir_valeurs_arbre_binaire(a_arbre, true, l_noyau,
+			&l_affine)) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire.");
 	}
-    return l_erreur;
 }
 
 /**
- *  \brief Inscrit l'erreur dans l''arbre'
+ *  \brief Remplace chaque valeur v de l''arbre' comprise entre 0 et
+ *         'nombre' par 'table'[v].
  *
- *  \param erreur Le texte de l'erreur.
+ *  \param arbre L'arbre_binaire dont les valeurs sont remplaces
+ *  \param table La table de remplacement
+ *  \param nombre Le nombre d'entres de la 'table'
  *
- *  \note 'arbre' ne doit pas tre NULL
+ *  \note 'arbre' et 'table' ne doivent pas tre NULL
  */
-void inscrire_erreur_arbre_binaire(arbre_binaire* a_arbre, const char* a_erreur)
+void remplacer_valeurs_arbre_binaire(arbre_binaire* a_arbre,
+		const valeur_arbre_binaire* a_table, taille_arbre_binaire a_nombre)
 {
-	a_arbre->a_erreur = true;
-    strncpy(a_arbre->erreur, a_erreur, ERREUR_TAILLE);
+	remplacement_arbre_binaire l_remplacement = {a_table, a_nombre};
+	noyau_arbre_binaire l_noyau = remplacement_scalaire_arbre_binaire;
+#ifdef ARBRE_BINAIRE_AVX2
+	if (avx2_arbre_binaire()) {
+		l_noyau = remplacement_avx2_arbre_binaire;
+	}
+#endif
+	if (verifier_modifiable_arbre_binaire(a_arbre) &&
+			!parcourir_valeurs_arbre_binaire(a_arbre, true, l_noyau,
+			&l_remplacement)) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire.");
+	}
 }
 
 /**
- *  \brief Retire tout erreur dans l''arbre'
+ *  \brief Calcule la somme, la plus petite et la plus grande des valeurs
+ *         de l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire  rsumer
+ *  \param somme Reoit la somme des valeurs, modulo 2^64 (peut tre NULL)
+ *  \param minimum Reoit la plus petite valeur (peut tre NULL)
+ *  \param maximum Reoit la plus grande valeur (peut tre NULL)
  *
  *  \note 'arbre' ne doit pas tre NULL
  */
-void retirer_erreur_arbre_binaire(arbre_binaire* a_arbre)
+void statistiques_arbre_binaire(arbre_binaire* a_arbre, int64_t* a_somme,
+		valeur_arbre_binaire* a_minimum, valeur_arbre_binaire* a_maximum)
 {
-	a_arbre->a_erreur = false;
-	if (a_arbre->premier_enfant) {
-		retirer_erreur_arbre_binaire(a_arbre->premier_enfant);
+	resume_arbre_binaire l_resume = {0, VALEUR_MAXIMALE, VALEUR_MINIMALE};
+	noyau_arbre_binaire l_noyau = resume_scalaire_arbre_binaire;
+#ifdef ARBRE_BINAIRE_AVX2
+	if (avx2_arbre_binaire()) {
+		l_noyau = resume_avx2_arbre_binaire;
 	}
-	if (a_arbre->second_enfant) {
-		retirer_erreur_arbre_binaire(a_arbre->second_enfant);
+#endif
+	if (!parcourir_valeurs_arbre_binaire(a_arbre, false, l_noyau,
+			&l_resume)) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire.");
+	}
+	if (a_somme) {
+		*a_somme = l_resume.somme;
+	}
+	if (a_minimum) {
+		*a_minimum = l_resume.minimum;
+	}
+	if (a_maximum) {
+		*a_maximum = l_resume.maximum;
+	}
+}
+
+/**
+ *  \brief Compte les valeurs de l''arbre' dans 'nombre' intervalles de
+ *         'largeur' valeurs  partir de 'minimum'.
+ *
+ *  L'intervalle i contient les valeurs v telles que
+ *  'minimum' + i * 'largeur' <= v < 'minimum' + (i + 1) * 'largeur'. Les
+ *  valeurs hors des intervalles ne sont pas comptes.
+ *
+ *  \param arbre L'arbre_binaire dont les valeurs sont comptes
+ *  \param minimum Le dbut du premier intervalle
+ *  \param largeur La largeur de chaque intervalle
+ *  \param compteurs Reoit le nombre de valeurs de chaque intervalle
+ *  \param nombre Le nombre d'intervalles
+ *
+ *  \note 'arbre' et 'compteurs' ne doivent pas tre NULL et 'largeur' doit
+ *  tre positive
+ */
+void histogramme_arbre_binaire(arbre_binaire* a_arbre,
+		valeur_arbre_binaire a_minimum, valeur_arbre_binaire a_largeur,
+		taille_arbre_binaire* a_compteurs, taille_arbre_binaire a_nombre)
+{
+	intervalles_arbre_binaire l_intervalles = {a_minimum, a_largeur,
+		a_compteurs, a_nombre};
+	memset(a_compteurs, 0, a_nombre * sizeof(taille_arbre_binaire));
+	if (!parcourir_valeurs_arbre_binaire(a_arbre, false,
+			intervalles_scalaire_arbre_binaire, &l_intervalles)) {
+		inscrire_erreur_arbre_binaire(a_arbre,
+			"Ne peux pas allouer la mmoire.");
 	}
 }
 
@@ -39,15 +39,63 @@
 #define _arbre_binaire_h
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 
 #define ERREUR_TAILLE 255
 
+/**
+ * \brief La valeur d'un noeud et le nombre de noeuds d'un arbre.
+ *
+ * Si ARBRE_BINAIRE_64 est défini lors de la compilation, les valeurs et les
+ * nombres de noeuds sont sur 64 bits afin de supporter les arbres de plus
+ * de 2^31 noeuds. Les fichiers et les tampons sérialisés de cette variante
+ * commencent par un en-tête qui indique la version du format et la taille de
+ * 'valeur_arbre_binaire'; l'autre variante refuse de les charger. Sans
+ * ARBRE_BINAIRE_64, l'arbre est sérialisé sans en-tête, dans le format des
+ * versions précédentes. Les deux variantes chargent ce format sans en-tête,
+ * dont les valeurs sont des 'int'.
+ */
+#ifdef ARBRE_BINAIRE_64
+typedef int64_t valeur_arbre_binaire;
+typedef int64_t taille_arbre_binaire;
+#else
+typedef int valeur_arbre_binaire;
+typedef int taille_arbre_binaire;
+#endif
+
 /**
  * \brief Un arbre binaire qui contient une valeur et des enfants.
  */
 typedef struct arbre_binaire_struct arbre_binaire;
 
+/**
+ * \brief Désalloue des arbres binaires dans un fil d'exécution séparé.
+ */
+typedef struct recuperateur_arbre_binaire_struct recuperateur_arbre_binaire;
+
+/**
+ * \brief Les noeuds d'un arbre binaire numérotés pour répondre en temps
+ *        constant aux requêtes d'ancêtres.
+ */
+typedef struct ancetres_arbre_binaire_struct ancetres_arbre_binaire;
+
+/**
+ * \brief Table des noeuds uniques utilisée lors du partage des sous-arbres.
+ */
+typedef struct table_partage_arbre_binaire_struct table_partage_arbre_binaire;
+
+/**
+ * \brief Fonction appelée pour chaque différence entre deux arbres.
+ *
+ * Si le premier noeud est NULL, le sous-arbre du second noeud a été ajouté.
+ * Si le second noeud est NULL, le sous-arbre du premier noeud a été retiré.
+ * Sinon, les valeurs des deux noeuds sont différentes.
+ */
+typedef void (*fonction_difference_arbre_binaire)(arbre_binaire* arbre1,
+		arbre_binaire* arbre2, void* donnees);
+
 /**
  *  \brief Créer un nouvel arbre binaire.
  *  
@@ -55,7 +103,7 @@ typedef struct arbre_binaire_struct arbre_binaire;
  *
  *  \return L'arbre binaire
  */
-arbre_binaire* creer_arbre_binaire(int valeur);
+arbre_binaire* creer_arbre_binaire(valeur_arbre_binaire valeur);
 
 /**
  *  \brief Créer un nouvel arbre_binaire depuis un fichier.
@@ -64,6 +112,16 @@ arbre_binaire* creer_arbre_binaire(int valeur);
  *  'nom_fichier' dans l'arbre. Si le fichier n'est pas valide, indique
  *  l'erreur dans 'arbre'->'erreur'.
  *
+ *  Le fichier est lu en entier et vérifié avant de créer l'arbre, y compris
+ *  son en-tête (signature, version du format et taille des valeurs) s'il en
+ *  a un; un fichier sans en-tête est lu dans le format des versions
+ *  précédentes. Tous les
+ *  noeuds sont alloués dans un seul bloc, qui est désalloué lorsque tous
+ *  ses noeuds l'ont été. Un sous-arbre détaché par
+ *  'detacher_premier_enfant_arbre_binaire' ou
+ *  'detacher_second_enfant_arbre_binaire' garde donc tout le bloc en mémoire
+ *  tant qu'il existe, même si le reste de l'arbre a été désalloué.
+ *
  *  \param nom_fichier Le nom du fichier contenant l'arbre
  *
  *  \return L'arbre_binaire
@@ -76,6 +134,8 @@ arbre_binaire* charger_arbre_binaire(char *nom_fichier);
 /**
  *  \brief Effectue la désallocation d'un arbre_binaire
  *
+ *  Si l''arbre' est partagé, seule la référence est retirée.
+ *
  *  \param arbre L'arbre_binaire à désallouer
  */
 void detruire_arbre_binaire(arbre_binaire* arbre);
@@ -85,6 +145,8 @@ void detruire_arbre_binaire(arbre_binaire* arbre);
  *
  *  Sauvegarde le contenue de l''arbre' dans le fichier 'nom_fichier'.
  *  Si le fichier n'est pas valide, indique l'erreur dans 'arbre'->'erreur'.
+ *  Seule l'erreur de l''arbre' est retirée au départ; celles de ses
+ *  descendants sont conservées.
  *
  *  \param arbre L'arbre_binaire
  *  \param nom_fichier Le nom du fichier à sauvegarder l'arbre
@@ -102,7 +164,7 @@ void sauvegarder_arbre_binaire(arbre_binaire* arbre, char * nom_fichier);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-int nombre_elements_arbre_binaire(arbre_binaire* arbre);
+taille_arbre_binaire nombre_elements_arbre_binaire(arbre_binaire* arbre);
 
 /**
  *  \brief Renvoie le nombre de feuilles de l''arbre'
@@ -113,7 +175,7 @@ int nombre_elements_arbre_binaire(arbre_binaire* arbre);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-int nombre_feuilles_arbre_binaire(arbre_binaire* arbre);
+taille_arbre_binaire nombre_feuilles_arbre_binaire(arbre_binaire* arbre);
 
 /**
  *  \brief Renvoie la hauteur de l''arbre'
@@ -124,7 +186,7 @@ int nombre_feuilles_arbre_binaire(arbre_binaire* arbre);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-int hauteur_arbre_binaire(arbre_binaire* arbre);
+taille_arbre_binaire hauteur_arbre_binaire(arbre_binaire* arbre);
 
 /**
  *  \brief Renvoie l'élément contenu dans la racine de l''arbre'
@@ -135,17 +197,21 @@ int hauteur_arbre_binaire(arbre_binaire* arbre);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-int element_arbre_binaire(arbre_binaire* arbre);
+valeur_arbre_binaire element_arbre_binaire(arbre_binaire* arbre);
 
 /**
  *  \brief Modifie l'élément contenu dans la racine de l''arbre'
  *
+ *  Si l''arbre' est partagé, indique l'erreur dans l''arbre' sans le
+ *  modifier.
+ *
  *  \param arbre L'arbre_binaire
  *  \param valeur La valeur à mettre dans la racine de l''arbre'
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-void modifier_element_arbre_binaire(arbre_binaire* arbre, int valeur);
+void modifier_element_arbre_binaire(arbre_binaire* arbre,
+		valeur_arbre_binaire valeur);
 
 /**
  *  \brief Regarde dans l''arbre' s'il contient la 'valeur'.
@@ -157,12 +223,23 @@ void modifier_element_arbre_binaire(arbre_binaire* arbre, int valeur);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-bool contient_element_arbre_binaire(arbre_binaire* arbre, int valeur);
+bool contient_element_arbre_binaire(arbre_binaire* arbre,
+		valeur_arbre_binaire valeur);
 
 /**
  *  \brief Retourne le premier enfant de l''arbre' ou 'NULL' si l''arbre' n'a
  *         pas de premier enfant.
  *
+ *  Si l''arbre' n'a pas cet enfant, indique l'erreur dans l''arbre'; sinon,
+ *  retire l'erreur de l''arbre', mais pas celles de ses descendants.
+ *
+ *  L'enfant retourné peut être partagé. Il ne doit alors qu'être lu. Si
+ *  l''arbre' a été chargé paresseusement avec un budget, l'enfant n'est pas
+ *  épinglé: il peut être désalloué par une lecture ultérieure du fichier,
+ *  sauf s'il contient le noeud en cours d'utilisation. Utiliser
+ *  'premier_enfant_epingle_arbre_binaire' pour conserver l'enfant pendant
+ *  que d'autres parties de l'arbre sont parcourues.
+ *
  *  \param arbre L'arbre_binaire à regarder son premier enfant.
  *
  *  \return le premier enfant de l''arbre'
@@ -171,6 +248,38 @@ bool contient_element_arbre_binaire(arbre_binaire* arbre, int valeur);
  */
 arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* arbre);
 
+/**
+ *  \brief Retourne le premier enfant de l''arbre' en l'épinglant.
+ *
+ *  Si l''arbre' a été chargé paresseusement, l'enfant reste en mémoire tant
+ *  qu'il n'a pas été relâché par 'relacher_arbre_binaire'. Sinon, se
+ *  comporte comme 'premier_enfant_arbre_binaire'.
+ *
+ *  \param arbre L'arbre_binaire à regarder son premier enfant.
+ *
+ *  \return le premier enfant de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+arbre_binaire* premier_enfant_epingle_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Retourne le premier enfant de l''arbre' en s'assurant qu'il peut être
+ *         modifié.
+ *
+ *  Si le premier enfant est partagé, il est d'abord copié afin de pouvoir être
+ *  modifié sans affecter les autres arbres qui le partagent. Si l''arbre'
+ *  est lui-même partagé ou n'a pas de premier enfant, indique l'erreur dans
+ *  l''arbre' et retourne NULL.
+ *
+ *  \param arbre L'arbre_binaire à regarder son premier enfant.
+ *
+ *  \return le premier enfant de l''arbre' ou NULL en cas d'erreur
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+arbre_binaire* premier_enfant_modifiable_arbre_binaire(arbre_binaire* arbre);
+
 /**
  *  \brief Ajoute un premier enfant d'un 'arbre' et place la valeur dans la
  *         racine de cet enfant.
@@ -180,7 +289,8 @@ arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* arbre);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-void creer_premier_enfant_arbre_binaire(arbre_binaire* arbre, int valeur);
+void creer_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+		valeur_arbre_binaire valeur);
 
 /**
  *  \brief Libère le premier enfant d'un 'arbre'.
@@ -195,6 +305,16 @@ void retirer_premier_enfant_arbre_binaire(arbre_binaire* arbre);
  *  \brief Retourne le second enfant de l''arbre' ou 'NULL' si l''arbre' n'a
  *         pas de second enfant.
  *
+ *  Si l''arbre' n'a pas cet enfant, indique l'erreur dans l''arbre'; sinon,
+ *  retire l'erreur de l''arbre', mais pas celles de ses descendants.
+ *
+ *  L'enfant retourné peut être partagé. Il ne doit alors qu'être lu. Si
+ *  l''arbre' a été chargé paresseusement avec un budget, l'enfant n'est pas
+ *  épinglé: il peut être désalloué par une lecture ultérieure du fichier,
+ *  sauf s'il contient le noeud en cours d'utilisation. Utiliser
+ *  'second_enfant_epingle_arbre_binaire' pour conserver l'enfant pendant
+ *  que d'autres parties de l'arbre sont parcourues.
+ *
  *  \param arbre L'arbre_binaire à regarder son second enfant.
  *
  *  \return le second enfant de l''arbre'
@@ -203,6 +323,38 @@ void retirer_premier_enfant_arbre_binaire(arbre_binaire* arbre);
  */
 arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* arbre);
 
+/**
+ *  \brief Retourne le second enfant de l''arbre' en l'épinglant.
+ *
+ *  Si l''arbre' a été chargé paresseusement, l'enfant reste en mémoire tant
+ *  qu'il n'a pas été relâché par 'relacher_arbre_binaire'. Sinon, se
+ *  comporte comme 'second_enfant_arbre_binaire'.
+ *
+ *  \param arbre L'arbre_binaire à regarder son second enfant.
+ *
+ *  \return le second enfant de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+arbre_binaire* second_enfant_epingle_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Retourne le second enfant de l''arbre' en s'assurant qu'il peut être
+ *         modifié.
+ *
+ *  Si le second enfant est partagé, il est d'abord copié afin de pouvoir être
+ *  modifié sans affecter les autres arbres qui le partagent. Si l''arbre'
+ *  est lui-même partagé ou n'a pas de second enfant, indique l'erreur dans
+ *  l''arbre' et retourne NULL.
+ *
+ *  \param arbre L'arbre_binaire à regarder son second enfant.
+ *
+ *  \return le second enfant de l''arbre' ou NULL en cas d'erreur
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+arbre_binaire* second_enfant_modifiable_arbre_binaire(arbre_binaire* arbre);
+
 /**
  *  \brief Ajoute un second enfant d'un 'arbre' et place la valeur dans la
  *         racine de cet enfant.
@@ -212,7 +364,8 @@ arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* arbre);
  *
  *  \note 'arbre' ne doit pas être NULL
  */
-void creer_second_enfant_arbre_binaire(arbre_binaire* arbre, int valeur);
+void creer_second_enfant_arbre_binaire(arbre_binaire* arbre,
+		valeur_arbre_binaire valeur);
 
 /**
  *  \brief Libère le premier enfant d'un 'arbre'.
@@ -261,6 +414,768 @@ void inscrire_erreur_arbre_binaire(arbre_binaire* arbre, const char* erreur);
  */
 void retirer_erreur_arbre_binaire(arbre_binaire* arbre);
 
+/**
+ *  \brief Renvoie le hachage de la structure et des valeurs de l''arbre'
+ *
+ *  Le hachage de chaque sous-arbre est conservé et n'est recalculé que pour
+ *  les noeuds modifiés depuis le dernier calcul et leurs parents. Le calcul
+ *  n'est pas récursif et supporte donc les arbres de toute profondeur. Si la
+ *  mémoire manque, l'erreur est indiquée dans l''arbre' et la valeur
+ *  retournée n'est pas son hachage.
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return Le hachage de l''arbre'
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+uint64_t hachage_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Indique si deux arbres ont la même structure et les mêmes valeurs.
+ *
+ *  Compare les hachages des deux arbres. Lorsque ceux-ci sont déjà calculés,
+ *  la comparaison se fait en temps constant. Deux arbres différents peuvent
+ *  avoir le même hachage, avec une probabilité d'environ 2^-64; utiliser
+ *  'egal_strict_arbre_binaire' pour écarter ces collisions.
+ *
+ *  \param arbre1 Le premier arbre_binaire à comparer
+ *  \param arbre2 Le second arbre_binaire à comparer
+ *
+ *  \return true si les deux arbres ont le même hachage, false sinon.
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas être NULL
+ */
+bool egal_arbre_binaire(arbre_binaire* arbre1, arbre_binaire* arbre2);
+
+/**
+ *  \brief Indique si deux arbres ont la même structure et les mêmes valeurs
+ *         en confirmant l'égalité des hachages noeud par noeud.
+ *
+ *  Les arbres dont les hachages diffèrent sont écartés comme par
+ *  'egal_arbre_binaire'. Lorsque les hachages sont égaux, les deux arbres
+ *  sont parcourus, sauf les sous-arbres qu'ils partagent, ce qui prend un
+ *  temps proportionnel à leur taille.
+ *
+ *  \param arbre1 Le premier arbre_binaire à comparer
+ *  \param arbre2 Le second arbre_binaire à comparer
+ *
+ *  \return true si les deux arbres sont identiques, false sinon ou si la
+ *          mémoire a manqué.
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas être NULL
+ */
+bool egal_strict_arbre_binaire(arbre_binaire* arbre1, arbre_binaire* arbre2);
+
+/**
+ *  \brief Trouve les différences entre deux arbres.
+ *
+ *  Ne descend que dans les sous-arbres dont les hachages diffèrent et appelle
+ *  'fonction' pour chaque différence trouvée. Les sous-arbres sont écartés
+ *  sur la seule comparaison de leurs hachages, comme par
+ *  'egal_arbre_binaire'.
+ *
+ *  \param arbre1 L'arbre_binaire de départ
+ *  \param arbre2 L'arbre_binaire à comparer avec 'arbre1'
+ *  \param fonction La fonction appelée pour chaque différence ou NULL
+ *  \param donnees Les données à donner à 'fonction'
+ *
+ *  \return Le nombre de différences trouvées
+ *
+ *  \note 'arbre1' et 'arbre2' ne doivent pas être NULL
+ */
+taille_arbre_binaire difference_arbre_binaire(arbre_binaire* arbre1,
+		arbre_binaire* arbre2, fonction_difference_arbre_binaire fonction,
+		void* donnees);
+
+/**
+ *  \brief Place le 'sous_arbre' comme premier enfant de l''arbre' sans le
+ *         copier.
+ *
+ *  Le 'sous_arbre' est partagé et n'est désalloué que lorsque tous les
+ *  arbres qui le contiennent sont désalloués. Le 'sous_arbre' et ses
+ *  descendants ne peuvent plus être modifiés sur place; les modifications
+ *  passent par 'premier_enfant_modifiable_arbre_binaire' qui en fait une copie.
+ *  Si l''arbre' est partagé, a déjà un premier enfant ou est contenu dans le
+ *  'sous_arbre', indique l'erreur dans l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire qui reçoit le premier enfant
+ *  \param sous_arbre L'arbre_binaire à partager
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas être NULL
+ */
+void partager_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+		arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Place le 'sous_arbre' comme second enfant de l''arbre' sans le
+ *         copier.
+ *
+ *  Le 'sous_arbre' est partagé et n'est désalloué que lorsque tous les
+ *  arbres qui le contiennent sont désalloués. Le 'sous_arbre' et ses
+ *  descendants ne peuvent plus être modifiés sur place; les modifications
+ *  passent par 'second_enfant_modifiable_arbre_binaire' qui en fait une copie.
+ *  Si l''arbre' est partagé, a déjà un second enfant ou est contenu dans le
+ *  'sous_arbre', indique l'erreur dans l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire qui reçoit le second enfant
+ *  \param sous_arbre L'arbre_binaire à partager
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas être NULL
+ */
+void partager_second_enfant_arbre_binaire(arbre_binaire* arbre,
+		arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Partage tous les sous-arbres identiques de l''arbre'.
+ *
+ *  Les sous-arbres ayant la même structure et les mêmes valeurs ne sont
+ *  conservés qu'une seule fois. Un sous-arbre partagé est copié lorsqu'il
+ *  est obtenu par 'premier_enfant_modifiable_arbre_binaire' ou
+ *  'second_enfant_modifiable_arbre_binaire'.
+ *
+ *  Un noeud partagé ne connaît pas ses parents et ne peut donc pas être
+ *  copié lorsqu'il est modifié directement. Après l'appel, un enfant obtenu
+ *  par 'premier_enfant_arbre_binaire' ou 'second_enfant_arbre_binaire' peut
+ *  être partagé: les routines qui le modifient, comme
+ *  'creer_second_enfant_arbre_binaire', indiquent alors l'erreur
+ *  « L'arbre est partagé et ne peut pas être modifié. » dans ce noeud et le
+ *  laissent inchangé. Les modifications doivent passer par les routines
+ *  '*_enfant_modifiable_arbre_binaire'.
+ *
+ *  \param arbre L'arbre_binaire à compacter
+ *
+ *  \return Le nombre de noeuds libérés
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ *  \note Les enfants de l''arbre' obtenus avant l'appel ne sont plus valides
+ */
+taille_arbre_binaire compacter_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Créer une table qui construit des arbres dont les sous-arbres
+ *         identiques sont partagés dès leur création.
+ *
+ *  \return La table_partage_arbre_binaire ou NULL en cas d'erreur
+ */
+table_partage_arbre_binaire* creer_table_partage_arbre_binaire(void);
+
+/**
+ *  \brief Désalloue la 'table'.
+ *
+ *  Les arbres construits par la 'table' restent valides et doivent être
+ *  désalloués séparément.
+ *
+ *  \param table La table_partage_arbre_binaire à désallouer
+ */
+void detruire_table_partage_arbre_binaire(table_partage_arbre_binaire* table);
+
+/**
+ *  \brief Retourne le noeud unique de la 'table' qui contient la 'valeur' et
+ *         les deux enfants, en le créant s'il n'existe pas encore.
+ *
+ *  La référence de l'appelant vers chaque enfant est transférée au noeud
+ *  retourné. Le noeud retourné est partagé et ne peut pas être modifié. Un
+ *  enfant qui n'a pas été construit par la 'table' devient partagé, avec
+ *  tous ses descendants, et ne peut plus être modifié non plus.
+ *
+ *  \param table La table_partage_arbre_binaire
+ *  \param valeur La valeur à mettre dans la racine du noeud
+ *  \param premier_enfant Le premier enfant ou NULL
+ *  \param second_enfant Le second enfant ou NULL
+ *
+ *  \return Le noeud unique ou NULL en cas d'erreur
+ *
+ *  \note 'table' ne doit pas être NULL
+ *  \note Le noeud retourné doit être désalloué avec 'detruire_arbre_binaire'
+ */
+arbre_binaire* construire_partage_arbre_binaire(
+		table_partage_arbre_binaire* table, valeur_arbre_binaire valeur,
+		arbre_binaire* premier_enfant, arbre_binaire* second_enfant);
+
+/**
+ *  \brief Créer un récupérateur qui désalloue les arbres en arrière-plan.
+ *
+ *  Les arbres déposés dans le récupérateur sont désalloués par un fil
+ *  d'exécution séparé. Lorsque 'capacite' arbres sont en attente, les
+ *  dépôts suivants attendent qu'un arbre soit pris en charge.
+ *
+ *  \param capacite Le nombre maximal d'arbres en attente de désallocation
+ *
+ *  \return Le recuperateur_arbre_binaire ou NULL en cas d'erreur
+ */
+recuperateur_arbre_binaire* creer_recuperateur_arbre_binaire(int capacite);
+
+/**
+ *  \brief Désalloue tous les arbres en attente puis le 'recuperateur'.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire à désallouer
+ */
+void detruire_recuperateur_arbre_binaire(
+		recuperateur_arbre_binaire* recuperateur);
+
+/**
+ *  \brief Attend que tous les arbres déposés dans le 'recuperateur' soient
+ *         désalloués.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire
+ *
+ *  \note 'recuperateur' ne doit pas être NULL
+ */
+void vider_recuperateur_arbre_binaire(recuperateur_arbre_binaire* recuperateur);
+
+/**
+ *  \brief Renvoie le nombre d'arbres qui ne sont pas encore désalloués.
+ *
+ *  \param recuperateur Le recuperateur_arbre_binaire
+ *
+ *  \return Le nombre d'arbres en attente de désallocation
+ *
+ *  \note 'recuperateur' ne doit pas être NULL
+ */
+int en_attente_recuperateur_arbre_binaire(
+		recuperateur_arbre_binaire* recuperateur);
+
+/**
+ *  \brief Effectue la désallocation d'un arbre_binaire en arrière-plan.
+ *
+ *  \param arbre L'arbre_binaire à désallouer
+ *  \param recuperateur Le recuperateur_arbre_binaire qui désalloue l''arbre'
+ *
+ *  \note 'arbre' et 'recuperateur' ne doivent pas être NULL
+ */
+void detruire_differe_arbre_binaire(arbre_binaire* arbre,
+		recuperateur_arbre_binaire* recuperateur);
+
+/**
+ *  \brief Retire le premier enfant d'un 'arbre' et le désalloue en
+ *         arrière-plan.
+ *
+ *  \param arbre L'arbre_binaire à retirer le premier enfant
+ *  \param recuperateur Le recuperateur_arbre_binaire qui désalloue l'enfant
+ *
+ *  \note 'arbre' et 'recuperateur' ne doivent pas être NULL
+ */
+void retirer_premier_enfant_differe_arbre_binaire(arbre_binaire* arbre,
+		recuperateur_arbre_binaire* recuperateur);
+
+/**
+ *  \brief Retire le second enfant d'un 'arbre' et le désalloue en
+ *         arrière-plan.
+ *
+ *  \param arbre L'arbre_binaire à retirer le second enfant
+ *  \param recuperateur Le recuperateur_arbre_binaire qui désalloue l'enfant
+ *
+ *  \note 'arbre' et 'recuperateur' ne doivent pas être NULL
+ */
+void retirer_second_enfant_differe_arbre_binaire(arbre_binaire* arbre,
+		recuperateur_arbre_binaire* recuperateur);
+
+/**
+ *  \brief Reconstruit l''arbre' pour qu'il ait la plus petite hauteur
+ *         possible en conservant l'ordre infixe de ses valeurs.
+ *
+ *  Les noeuds existants sont réutilisés par rotations, sans allocation
+ *  (algorithme de Day-Stout-Warren). L''arbre' reste la racine du résultat.
+ *  Les sous-arbres partagés rencontrés sont copiés.
+ *
+ *  \param arbre L'arbre_binaire à équilibrer
+ *
+ *  \return true si l''arbre' a été équilibré, false s'il est partagé ou si
+ *          la mémoire n'a pu être allouée (l'erreur est alors indiquée dans
+ *          l''arbre').
+ *
+ *  \note 'arbre' ne doit pas être NULL ni partagé
+ *  \note Les enfants de l''arbre' obtenus avant l'appel peuvent avoir changé
+ *        de position
+ */
+bool equilibrer_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Équilibre l''arbre' si sa hauteur dépasse 'facteur' fois la
+ *         hauteur minimale.
+ *
+ *  \param arbre L'arbre_binaire à équilibrer
+ *  \param facteur Le rapport maximal entre la hauteur et la hauteur minimale
+ *
+ *  \return true si l''arbre' a été équilibré, false s'il n'avait pas à
+ *          l'être ou si 'equilibrer_arbre_binaire' a échoué.
+ *
+ *  \note 'arbre' ne doit pas être NULL ni partagé
+ */
+bool equilibrer_si_necessaire_arbre_binaire(arbre_binaire* arbre,
+		double facteur);
+
+/**
+ *  \brief Sauvegarde plusieurs arbres, chacun dans son fichier.
+ *
+ *  Sauvegarde 'arbres'[i] dans le fichier 'noms_fichiers'[i]. Les fichiers
+ *  sont ouverts, écrits et fermés en parallèle à l'aide d'io_uring lorsqu'il
+ *  est disponible, sinon à l'aide d'un groupe de fils d'exécution. Les arbres
+ *  sont sérialisés au préalable par le fil appelant, un même arbre peut donc
+ *  apparaître plusieurs fois dans 'arbres'. Si un fichier n'est pas valide,
+ *  indique l'erreur dans l'arbre correspondant.
+ *
+ *  \param arbres Les arbres à sauvegarder
+ *  \param noms_fichiers Les noms des fichiers où sauvegarder les 'arbres'
+ *  \param nombre Le nombre d'arbres à sauvegarder
+ *
+ *  \return Le nombre de fichiers qui n'ont pas pu être sauvegardés
+ *
+ *  \note Aucun des 'arbres' ne doit être NULL
+ */
+int sauvegarder_lot_arbre_binaire(arbre_binaire** arbres,
+		char** noms_fichiers, int nombre);
+
+/**
+ *  \brief Créer plusieurs arbres, chacun depuis son fichier.
+ *
+ *  Place dans 'arbres'[i] l'arbre chargé du fichier 'noms_fichiers'[i]. Les
+ *  fichiers sont ouverts, lus et fermés en parallèle à l'aide d'io_uring
+ *  lorsqu'il est disponible, sinon à l'aide d'un groupe de fils d'exécution.
+ *  Si un fichier n'est pas valide, indique l'erreur dans l'arbre
+ *  correspondant. Si la mémoire manque même pour créer cet arbre,
+ *  'arbres'[i] est NULL.
+ *
+ *  \param arbres Reçoit les arbres chargés
+ *  \param noms_fichiers Les noms des fichiers contenant les arbres
+ *  \param nombre Le nombre d'arbres à charger
+ *
+ *  \return Le nombre d'arbres qui n'ont pas pu être chargés
+ *
+ *  \note Les fichiers doivent être créés à l'aide de la routine
+ *  “sauvegarder_arbre_binaire” ou “sauvegarder_lot_arbre_binaire”
+ */
+int charger_lot_arbre_binaire(arbre_binaire** arbres,
+		char** noms_fichiers, int nombre);
+
+/**
+ *  \brief Prépare les requêtes d'ancêtres sur l''arbre'.
+ *
+ *  Numérote les noeuds de l''arbre' dans l'ordre préfixe (la racine porte le
+ *  numéro 0). Les noeuds sont groupés en blocs de 64: un masque par noeud
+ *  retrouve le moins profond d'un intervalle à l'intérieur d'un bloc et une
+ *  table creuse, construite sur le moins profond de chaque bloc, couvre les
+ *  blocs entiers. La préparation se fait en temps et en mémoire
+ *  proportionnels au nombre de noeuds et chaque requête en temps constant.
+ *  Les numéros restent valides tant que l''arbre' n'est pas modifié.
+ *
+ *  \param arbre L'arbre_binaire à préparer
+ *
+ *  \return L'ancetres_arbre_binaire ou NULL si la mémoire a manqué
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+ancetres_arbre_binaire* creer_ancetres_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Effectue la désallocation d'un ancetres_arbre_binaire.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire à désallouer
+ */
+void detruire_ancetres_arbre_binaire(ancetres_arbre_binaire* ancetres);
+
+/**
+ *  \brief Renvoie le nombre de noeuds numérotés dans les 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *
+ *  \return Le nombre de noeuds
+ *
+ *  \note 'ancetres' ne doit pas être NULL
+ */
+taille_arbre_binaire nombre_noeuds_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* ancetres);
+
+/**
+ *  \brief Renvoie le numéro d'un 'noeud' dans les 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param noeud Le noeud à rechercher
+ *
+ *  \return Le numéro du 'noeud' ou -1 s'il n'en fait pas partie
+ *
+ *  \note 'ancetres' ne doit pas être NULL
+ *  \note Un sous-arbre partagé porte le numéro de sa première occurrence
+ */
+taille_arbre_binaire numero_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* ancetres,
+		arbre_binaire* noeud);
+
+/**
+ *  \brief Renvoie le noeud portant le 'numero' dans les 'ancetres'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numero Le numéro du noeud
+ *
+ *  \return Le noeud
+ *
+ *  \note 'numero' doit être entre 0 et le nombre de noeuds
+ */
+arbre_binaire* noeud_ancetres_arbre_binaire(ancetres_arbre_binaire* ancetres,
+		taille_arbre_binaire numero);
+
+/**
+ *  \brief Renvoie la profondeur du noeud 'numero'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numero Le numéro du noeud
+ *
+ *  \return La profondeur du noeud, 0 pour la racine
+ *
+ *  \note 'numero' doit être entre 0 et le nombre de noeuds
+ */
+taille_arbre_binaire profondeur_ancetres_arbre_binaire(
+		ancetres_arbre_binaire* ancetres, taille_arbre_binaire numero);
+
+/**
+ *  \brief Indique si le noeud 'ancetre' est un ancêtre du noeud
+ *         'descendant'.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param ancetre Le numéro de l'ancêtre
+ *  \param descendant Le numéro du descendant
+ *
+ *  \return true si 'ancetre' est 'descendant' ou un de ses ancêtres.
+ *
+ *  \note 'ancetre' et 'descendant' doivent être entre 0 et le nombre de
+ *        noeuds
+ */
+bool est_ancetre_arbre_binaire(ancetres_arbre_binaire* ancetres,
+		taille_arbre_binaire ancetre, taille_arbre_binaire descendant);
+
+/**
+ *  \brief Renvoie le plus proche ancêtre commun de deux noeuds.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numero1 Le numéro du premier noeud
+ *  \param numero2 Le numéro du second noeud
+ *
+ *  \return Le numéro du plus proche ancêtre commun
+ *
+ *  \note 'numero1' et 'numero2' doivent être entre 0 et le nombre de noeuds
+ */
+taille_arbre_binaire ancetre_commun_arbre_binaire(
+		ancetres_arbre_binaire* ancetres, taille_arbre_binaire numero1,
+		taille_arbre_binaire numero2);
+
+/**
+ *  \brief Renvoie le plus proche ancêtre commun de plusieurs paires de
+ *         noeuds.
+ *
+ *  \param ancetres L'ancetres_arbre_binaire
+ *  \param numeros1 Les numéros des premiers noeuds de chaque paire
+ *  \param numeros2 Les numéros des seconds noeuds de chaque paire
+ *  \param resultats Reçoit le numéro de l'ancêtre commun de chaque paire
+ *  \param nombre Le nombre de paires
+ *
+ *  \note 'ancetres' ne doit pas être NULL
+ */
+void ancetres_communs_lot_arbre_binaire(ancetres_arbre_binaire* ancetres,
+		const taille_arbre_binaire* numeros1,
+		const taille_arbre_binaire* numeros2, taille_arbre_binaire* resultats,
+		taille_arbre_binaire nombre);
+
+/**
+ *  \brief Retire le premier enfant de l''arbre' sans le désallouer.
+ *
+ *  Le sous-arbre retourné devient un arbre indépendant qui doit être greffé
+ *  ou désalloué par l'appelant. Si l''arbre' n'a pas de premier enfant,
+ *  indique l'erreur dans l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire à détacher le premier enfant
+ *
+ *  \return Le premier enfant détaché ou NULL s'il n'existe pas
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+arbre_binaire* detacher_premier_enfant_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Retire le second enfant de l''arbre' sans le désallouer.
+ *
+ *  Le sous-arbre retourné devient un arbre indépendant qui doit être greffé
+ *  ou désalloué par l'appelant. Si l''arbre' n'a pas de second enfant,
+ *  indique l'erreur dans l''arbre'.
+ *
+ *  \param arbre L'arbre_binaire à détacher le second enfant
+ *
+ *  \return Le second enfant détaché ou NULL s'il n'existe pas
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+arbre_binaire* detacher_second_enfant_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Place le 'sous_arbre' comme premier enfant de l''arbre'.
+ *
+ *  Le 'sous_arbre' appartient ensuite à l''arbre' et est désalloué avec
+ *  lui. Si l''arbre' a déjà un premier enfant ou si le 'sous_arbre' a déjà
+ *  un parent, indique l'erreur dans l''arbre'. Un 'sous_arbre' partagé,
+ *  c'est-à-dire placé par 'partager_premier_enfant_arbre_binaire',
+ *  construit par 'construire_partage_arbre_binaire' ou issu de
+ *  'compacter_arbre_binaire', est aussi refusé. Ces vérifications se font
+ *  en temps constant.
+ *
+ *  \param arbre L'arbre_binaire qui reçoit le premier enfant
+ *  \param sous_arbre L'arbre_binaire à greffer
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas être NULL
+ *  \note Le 'sous_arbre' ne doit pas contenir l''arbre'; utiliser
+ *  'greffer_premier_enfant_verifie_arbre_binaire' si ce n'est pas certain.
+ */
+void greffer_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+		arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Place le 'sous_arbre' comme premier enfant de l''arbre' après avoir
+ *         vérifié qu'il ne contient pas l''arbre'.
+ *
+ *  Se comporte comme 'greffer_premier_enfant_arbre_binaire', mais indique
+ *  aussi l'erreur dans l''arbre' si le 'sous_arbre' le contient. La
+ *  vérification remonte les parents de l''arbre' et prend donc un temps
+ *  proportionnel à sa profondeur.
+ *
+ *  \param arbre L'arbre_binaire qui reçoit le premier enfant
+ *  \param sous_arbre L'arbre_binaire à greffer
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas être NULL
+ */
+void greffer_premier_enfant_verifie_arbre_binaire(arbre_binaire* arbre,
+		arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Place le 'sous_arbre' comme second enfant de l''arbre'.
+ *
+ *  Le 'sous_arbre' appartient ensuite à l''arbre' et est désalloué avec
+ *  lui. Si l''arbre' a déjà un second enfant ou si le 'sous_arbre' a déjà
+ *  un parent, indique l'erreur dans l''arbre'. Un 'sous_arbre' partagé,
+ *  c'est-à-dire placé par 'partager_second_enfant_arbre_binaire',
+ *  construit par 'construire_partage_arbre_binaire' ou issu de
+ *  'compacter_arbre_binaire', est aussi refusé. Ces vérifications se font
+ *  en temps constant.
+ *
+ *  \param arbre L'arbre_binaire qui reçoit le second enfant
+ *  \param sous_arbre L'arbre_binaire à greffer
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas être NULL
+ *  \note Le 'sous_arbre' ne doit pas contenir l''arbre'; utiliser
+ *  'greffer_second_enfant_verifie_arbre_binaire' si ce n'est pas certain.
+ */
+void greffer_second_enfant_arbre_binaire(arbre_binaire* arbre,
+		arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Place le 'sous_arbre' comme second enfant de l''arbre' après avoir
+ *         vérifié qu'il ne contient pas l''arbre'.
+ *
+ *  Se comporte comme 'greffer_second_enfant_arbre_binaire', mais indique
+ *  aussi l'erreur dans l''arbre' si le 'sous_arbre' le contient. La
+ *  vérification remonte les parents de l''arbre' et prend donc un temps
+ *  proportionnel à sa profondeur.
+ *
+ *  \param arbre L'arbre_binaire qui reçoit le second enfant
+ *  \param sous_arbre L'arbre_binaire à greffer
+ *
+ *  \note 'arbre' et 'sous_arbre' ne doivent pas être NULL
+ */
+void greffer_second_enfant_verifie_arbre_binaire(arbre_binaire* arbre,
+		arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Renvoie le nombre d'octets nécessaires pour sérialiser l''arbre'.
+ *
+ *  Permet d'allouer un tampon de la taille exacte avant d'appeler
+ *  'serialiser_arbre_binaire'.
+ *
+ *  \param arbre L'arbre_binaire
+ *
+ *  \return La taille de l''arbre' sérialisé ou 0 si la mémoire a manqué
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+size_t taille_serialisation_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Sérialise l''arbre' dans un tampon fourni par l'appelant.
+ *
+ *  Le contenu du tampon est le même que celui d'un fichier créé par
+ *  'sauvegarder_arbre_binaire'. Si le 'tampon' est trop petit, indique
+ *  l'erreur dans l''arbre'. Seule l'erreur de l''arbre' est retirée au
+ *  départ.
+ *
+ *  \param arbre L'arbre_binaire à sérialiser
+ *  \param tampon Le tampon où écrire l''arbre'
+ *  \param capacite La taille du 'tampon'
+ *
+ *  \return Le nombre d'octets écrits ou 0 en cas d'erreur
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+size_t serialiser_arbre_binaire(arbre_binaire* arbre, void* tampon,
+		size_t capacite);
+
+/**
+ *  \brief Sérialise l''arbre' dans un tampon agrandi au besoin.
+ *
+ *  Le '*tampon' est agrandi avec realloc s'il est trop petit et la nouvelle
+ *  taille est placée dans '*capacite'. Le même tampon peut ainsi servir à
+ *  plusieurs sérialisations. Le '*tampon' doit être libéré avec free. Seule
+ *  l'erreur de l''arbre' est retirée au départ.
+ *
+ *  \param arbre L'arbre_binaire à sérialiser
+ *  \param tampon Le tampon alloué avec malloc ou NULL
+ *  \param capacite La taille du 'tampon'
+ *
+ *  \return Le nombre d'octets écrits ou 0 en cas d'erreur
+ *
+ *  \note 'arbre', 'tampon' et 'capacite' ne doivent pas être NULL
+ */
+size_t serialiser_extensible_arbre_binaire(arbre_binaire* arbre,
+		void** tampon, size_t* capacite);
+
+/**
+ *  \brief Créer un nouvel arbre_binaire depuis un tampon.
+ *
+ *  Si le 'tampon' n'est pas valide, notamment si son en-tête n'a pas la
+ *  version ou la taille des valeurs attendues, indique l'erreur dans l'arbre
+ *  retourné. Un tampon qui ne commence pas par un en-tête est lu dans le
+ *  format des versions précédentes.
+ *
+ *  \param tampon Le tampon contenant l'arbre sérialisé
+ *  \param taille La taille du 'tampon'
+ *
+ *  \return L'arbre_binaire
+ *
+ *  \note Le tampon doit être créé à l'aide de la routine
+ *  “serialiser_arbre_binaire” ou “serialiser_extensible_arbre_binaire”
+ */
+arbre_binaire* deserialiser_arbre_binaire(const void* tampon, size_t taille);
+
+/**
+ *  \brief Créer un nouvel arbre_binaire depuis un fichier en ne chargeant
+ *         que les premiers niveaux.
+ *
+ *  Seuls les 'profondeur' premiers niveaux sont créés. Les sous-arbres plus
+ *  profonds sont lus dans le fichier, 'profondeur' niveaux à la fois,
+ *  lorsque leurs noeuds sont utilisés par 'premier_enfant_arbre_binaire',
+ *  'second_enfant_arbre_binaire' ou une routine qui parcourt l'arbre.
+ *
+ *  Si 'budget' n'est pas 0, les sous-arbres non modifiés les moins
+ *  récemment utilisés sont désalloués lorsque plus de 'budget' noeuds ont
+ *  été chargés; ils seront relus au besoin. Les sous-arbres modifiés, ceux
+ *  qui contiennent le noeud en cours d'utilisation ou un noeud obtenu par
+ *  'premier_enfant_epingle_arbre_binaire' ou
+ *  'second_enfant_epingle_arbre_binaire' qui n'a pas encore été relâché par
+ *  'relacher_arbre_binaire' et ceux préparés par
+ *  'creer_ancetres_arbre_binaire', 'equilibrer_arbre_binaire' ou
+ *  'compacter_arbre_binaire' sont conservés.
+ *
+ *  L'ouverture lit tout le fichier une fois pour le valider et noter où se
+ *  termine chaque sous-arbre, ce qui demande un 'size_t' par noeud: le
+ *  format du fichier ne contient pas ces positions. L'ouverture prend donc
+ *  un temps et une mémoire proportionnels au nombre de noeuds, même si peu
+ *  d'entre eux sont ensuite chargés. Chaque morceau est ensuite lu sans
+ *  parcourir les sous-arbres qu'il ne contient pas.
+ *  Dans la variante ARBRE_BINAIRE_64, un fichier sans en-tête est chargé en
+ *  entier par 'charger_arbre_binaire'.
+ *
+ *  \param nom_fichier Le nom du fichier contenant l'arbre
+ *  \param profondeur Le nombre de niveaux chargés à la fois
+ *  \param budget Le nombre maximal de noeuds chargés ou 0 pour aucune limite
+ *
+ *  \return L'arbre_binaire
+ *
+ *  \note Le fichier doit être créé à l'aide de la routine
+ *  “sauvegarder_arbre_binaire” et ne doit pas être modifié tant que l'arbre
+ *  existe. Les noeuds obtenus autrement que par
+ *  'premier_enfant_epingle_arbre_binaire' ou
+ *  'second_enfant_epingle_arbre_binaire' ne sont pas épinglés et peuvent
+ *  avoir été désalloués après une autre lecture du fichier.
+ */
+arbre_binaire* charger_paresseux_arbre_binaire(char* nom_fichier,
+		int profondeur, size_t budget);
+
+/**
+ *  \brief Relâche un noeud obtenu par 'premier_enfant_epingle_arbre_binaire'
+ *         ou 'second_enfant_epingle_arbre_binaire'.
+ *
+ *  Si l''arbre' a été chargé par 'charger_paresseux_arbre_binaire', le
+ *  morceau qui le contient peut de nouveau être désalloué lorsque le budget
+ *  est dépassé. Sinon, ne fait rien.
+ *
+ *  \param arbre L'arbre_binaire à relâcher
+ *
+ *  \note 'arbre' ne doit pas être NULL et ne doit plus être utilisé après
+ *  l'appel s'il a été chargé paresseusement.
+ */
+void relacher_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Remplace chaque valeur v de l''arbre' par
+ *         v * 'facteur' + 'decalage'.
+ *
+ *  Les valeurs sont traitées par blocs contigus avec les instructions
+ *  vectorielles du processeur lorsqu'elles sont disponibles. Les sous-arbres
+ *  partagés sont copiés avant d'être modifiés. Si la mémoire manque,
+ *  l'erreur est indiquée dans l''arbre' et aucune valeur n'est modifiée.
+ *
+ *  \param arbre L'arbre_binaire à transformer
+ *  \param facteur Le facteur multiplié à chaque valeur
+ *  \param decalage Le décalage ajouté à chaque valeur
+ *
+ *  \note 'arbre' ne doit pas être NULL. Les dépassements sont calculés
+ *  modulo la taille de 'valeur_arbre_binaire'.
+ */
+void transformer_arbre_binaire(arbre_binaire* arbre,
+		valeur_arbre_binaire facteur, valeur_arbre_binaire decalage);
+
+/**
+ *  \brief Remplace chaque valeur v de l''arbre' comprise entre 0 et
+ *         'nombre' par 'table'[v]. Les autres valeurs sont conservées.
+ *
+ *  \param arbre L'arbre_binaire dont les valeurs sont remplacées
+ *  \param table La table de remplacement
+ *  \param nombre Le nombre d'entrées de la 'table'
+ *
+ *  \note 'arbre' et 'table' ne doivent pas être NULL
+ */
+void remplacer_valeurs_arbre_binaire(arbre_binaire* arbre,
+		const valeur_arbre_binaire* table, taille_arbre_binaire nombre);
+
+/**
+ *  \brief Calcule la somme, la plus petite et la plus grande des valeurs
+ *         de l''arbre' en un seul parcours.
+ *
+ *  \param arbre L'arbre_binaire à résumer
+ *  \param somme Reçoit la somme des valeurs, modulo 2^64 (peut être NULL)
+ *  \param minimum Reçoit la plus petite valeur (peut être NULL)
+ *  \param maximum Reçoit la plus grande valeur (peut être NULL)
+ *
+ *  \note 'arbre' ne doit pas être NULL
+ */
+void statistiques_arbre_binaire(arbre_binaire* arbre, int64_t* somme,
+		valeur_arbre_binaire* minimum, valeur_arbre_binaire* maximum);
+
+/**
+ *  \brief Compte les valeurs de l''arbre' dans 'nombre' intervalles de
+ *         'largeur' valeurs à partir de 'minimum'.
+ *
+ *  Les valeurs hors des intervalles ne sont pas comptées.
+ *
+ *  \param arbre L'arbre_binaire dont les valeurs sont comptées
+ *  \param minimum Le début du premier intervalle
+ *  \param largeur La largeur de chaque intervalle
+ *  \param compteurs Reçoit le nombre de valeurs de chaque intervalle
+ *  \param nombre Le nombre d'intervalles
+ *
+ *  \note 'arbre' et 'compteurs' ne doivent pas être NULL et 'largeur' doit
+ *  être positive
+ */
+void histogramme_arbre_binaire(arbre_binaire* arbre,
+		valeur_arbre_binaire minimum, valeur_arbre_binaire largeur,
+		taille_arbre_binaire* compteurs, taille_arbre_binaire nombre);
+
 #endif /* _arbre_binaire_h */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -54,6 +54,9 @@ int main()
 		sauvegarder_arbre_binaire(arbre1, "test.bin");
 		arbre2 = charger_arbre_binaire("test.bin");
 		arbre_binaire* enfant2 = premier_enfant_arbre_binaire(arbre2);
+		if (!egal_arbre_binaire(arbre1, arbre2)) {
+			printf("Erreur lors de la comparaison des arbres\n");
+		}
 		if (nombre_elements_arbre_binaire(arbre2) != 4) {
 			printf("Erreur lors du comptage d'éléments\n");
 		}
@@ -89,6 +92,262 @@ int main()
 		if (a_erreur_arbre_binaire(arbre2)) {
 			printf("L'erreur ne s'est pas enlevée\n");
 		}
+		if (difference_arbre_binaire(arbre1, arbre2, NULL, NULL) != 1) {
+			printf("Erreur lors de la recherche des différences\n");
+		}
+		arbre_binaire* arbre3 = creer_arbre_binaire(1);
+		creer_premier_enfant_arbre_binaire(arbre3, 2);
+		creer_second_enfant_arbre_binaire(arbre3, 2);
+		creer_premier_enfant_arbre_binaire(
+			premier_enfant_arbre_binaire(arbre3), 3);
+		creer_premier_enfant_arbre_binaire(
+			second_enfant_arbre_binaire(arbre3), 3);
+		if (compacter_arbre_binaire(arbre3) != 2 ||
+				premier_enfant_arbre_binaire(arbre3) !=
+				second_enfant_arbre_binaire(arbre3)) {
+			printf("Erreur lors du partage des sous-arbres\n");
+		}
+		modifier_element_arbre_binaire(second_enfant_arbre_binaire(arbre3), 4);
+		if (!a_erreur_arbre_binaire(second_enfant_arbre_binaire(arbre3)) ||
+				element_arbre_binaire(second_enfant_arbre_binaire(arbre3)) !=
+				2) {
+			printf("Erreur lors de la modification d'un noeud partagé\n");
+		}
+		modifier_element_arbre_binaire(
+			second_enfant_modifiable_arbre_binaire(arbre3), 4);
+		if (element_arbre_binaire(premier_enfant_arbre_binaire(arbre3)) != 2 ||
+				element_arbre_binaire(second_enfant_arbre_binaire(arbre3)) !=
+				4 || nombre_elements_arbre_binaire(arbre3) != 5) {
+			printf("Erreur lors de la copie d'un sous-arbre partagé\n");
+		}
+		table_partage_arbre_binaire* table_partage =
+			creer_table_partage_arbre_binaire();
+		arbre_binaire* feuille =
+			construire_partage_arbre_binaire(table_partage, 3, NULL, NULL);
+		arbre_binaire* branche1 =
+			construire_partage_arbre_binaire(table_partage, 2, feuille, NULL);
+		feuille =
+			construire_partage_arbre_binaire(table_partage, 3, NULL, NULL);
+		arbre_binaire* branche2 =
+			construire_partage_arbre_binaire(table_partage, 2, feuille, NULL);
+		arbre_binaire* construit = construire_partage_arbre_binaire(
+			table_partage, 1, branche1, branche2);
+		detruire_table_partage_arbre_binaire(table_partage);
+		if (premier_enfant_arbre_binaire(construit) !=
+				second_enfant_arbre_binaire(construit) ||
+				nombre_elements_arbre_binaire(construit) != 5) {
+			printf("Erreur lors de la construction d'un arbre partagé\n");
+		}
+		if (equilibrer_arbre_binaire(premier_enfant_arbre_binaire(construit))) {
+			printf("Erreur lors de l'équilibrage d'un arbre partagé\n");
+		}
+		detruire_arbre_binaire(construit);
+		recuperateur_arbre_binaire* recuperateur =
+			creer_recuperateur_arbre_binaire(4);
+		retirer_premier_enfant_differe_arbre_binaire(arbre3, recuperateur);
+		if (premier_enfant_arbre_binaire(arbre3)) {
+			printf("Erreur lors du retrait différé d'un enfant\n");
+		}
+		detruire_differe_arbre_binaire(arbre3, recuperateur);
+		vider_recuperateur_arbre_binaire(recuperateur);
+		if (en_attente_recuperateur_arbre_binaire(recuperateur) != 0) {
+			printf("Erreur lors de la désallocation différée\n");
+		}
+		detruire_recuperateur_arbre_binaire(recuperateur);
+		arbre_binaire* arbre4 = creer_arbre_binaire(1);
+		arbre_binaire* noeud = arbre4;
+		valeur_arbre_binaire valeur;
+		for (valeur = 2; valeur <= 7; valeur = valeur + 1) {
+			creer_second_enfant_arbre_binaire(noeud, valeur);
+			noeud = second_enfant_arbre_binaire(noeud);
+		}
+		if (!equilibrer_si_necessaire_arbre_binaire(arbre4, 1.0) ||
+				hauteur_arbre_binaire(arbre4) != 3 ||
+				element_arbre_binaire(arbre4) != 4 ||
+				element_arbre_binaire(premier_enfant_arbre_binaire(arbre4)) != 2) {
+			printf("Erreur lors de l'équilibrage\n");
+		}
+		if (equilibrer_si_necessaire_arbre_binaire(arbre4, 1.0)) {
+			printf("Erreur lors de l'équilibrage d'un arbre équilibré\n");
+		}
+		detruire_arbre_binaire(arbre4);
+		arbre_binaire* lot[3];
+		char* noms_lot[3] = {"test1.bin", "test2.bin", "inexistant/test3.bin"};
+		lot[0] = arbre1;
+		lot[1] = arbre2;
+		lot[2] = arbre1;
+		if (sauvegarder_lot_arbre_binaire(lot, noms_lot, 3) != 1) {
+			printf("Erreur lors de la sauvegarde d'un lot\n");
+		}
+		retirer_erreur_arbre_binaire(arbre1);
+		if (charger_lot_arbre_binaire(lot, noms_lot, 3) != 1 ||
+				!egal_arbre_binaire(lot[0], arbre1) ||
+				!egal_arbre_binaire(lot[1], arbre2) ||
+				!a_erreur_arbre_binaire(lot[2])) {
+			printf("Erreur lors du chargement d'un lot\n");
+		}
+		detruire_arbre_binaire(lot[0]);
+		detruire_arbre_binaire(lot[1]);
+		detruire_arbre_binaire(lot[2]);
+		ancetres_arbre_binaire* ancetres = creer_ancetres_arbre_binaire(arbre1);
+		taille_arbre_binaire numero7 = numero_ancetres_arbre_binaire(ancetres,
+			second_enfant_arbre_binaire(premier_enfant_arbre_binaire(arbre1)));
+		taille_arbre_binaire numero8 = numero_ancetres_arbre_binaire(ancetres,
+			second_enfant_arbre_binaire(arbre1));
+		if (ancetre_commun_arbre_binaire(ancetres, numero7, numero8) != 0 ||
+				profondeur_ancetres_arbre_binaire(ancetres, numero7) != 2 ||
+				!est_ancetre_arbre_binaire(ancetres, 1, numero7) ||
+				est_ancetre_arbre_binaire(ancetres, numero8, numero7)) {
+			printf("Erreur lors de la recherche d'ancêtres\n");
+		}
+		detruire_ancetres_arbre_binaire(ancetres);
+		arbre_binaire* arbre5 = creer_arbre_binaire(5);
+		arbre_binaire* branche = detacher_premier_enfant_arbre_binaire(arbre1);
+		greffer_second_enfant_arbre_binaire(arbre5, branche);
+		if (nombre_elements_arbre_binaire(arbre1) != 2 ||
+				nombre_elements_arbre_binaire(arbre5) != 3) {
+			printf("Erreur lors du déplacement d'un sous-arbre\n");
+		}
+		arbre_binaire* arbre6 = creer_arbre_binaire(6);
+		greffer_second_enfant_arbre_binaire(arbre5, arbre6);
+		if (!a_erreur_arbre_binaire(arbre5)) {
+			printf("Erreur lors de la greffe sur un enfant existant\n");
+		}
+		greffer_premier_enfant_verifie_arbre_binaire(branche, arbre5);
+		if (!a_erreur_arbre_binaire(branche) ||
+				premier_enfant_arbre_binaire(branche)) {
+			printf("Erreur lors de la greffe d'un ancêtre\n");
+		}
+		detruire_arbre_binaire(arbre6);
+		detruire_arbre_binaire(arbre5);
+		size_t taille = taille_serialisation_arbre_binaire(arbre2);
+		char* tampon = malloc(taille);
+		if (serialiser_arbre_binaire(arbre2, tampon, taille) != taille) {
+			printf("Erreur lors de la sérialisation\n");
+		}
+		arbre_binaire* arbre7 = deserialiser_arbre_binaire(tampon, taille);
+		if (!egal_strict_arbre_binaire(arbre7, arbre2)) {
+			printf("Erreur lors de la désérialisation\n");
+		}
+		detruire_arbre_binaire(arbre7);
+		arbre7 = deserialiser_arbre_binaire(tampon, taille - 1);
+		if (!a_erreur_arbre_binaire(arbre7)) {
+			printf("Erreur lors de la désérialisation d'un tampon incomplet\n");
+		}
+		detruire_arbre_binaire(arbre7);
+		tampon[5] = tampon[5] ^ 12;
+		arbre7 = deserialiser_arbre_binaire(tampon, taille);
+		if (!a_erreur_arbre_binaire(arbre7)) {
+			printf("Erreur lors de la vérification de l'en-tête\n");
+		}
+		detruire_arbre_binaire(arbre7);
+		free(tampon);
+		int ancien[6] = {7, 1, 0, 3, 0, 0};
+		FILE* fichier = fopen("test_v1.bin", "wb");
+		if (fichier) {
+			fwrite(ancien, sizeof(int), 6, fichier);
+			fclose(fichier);
+		}
+		arbre7 = charger_arbre_binaire("test_v1.bin");
+		if (a_erreur_arbre_binaire(arbre7) ||
+				element_arbre_binaire(arbre7) != 7 ||
+				!premier_enfant_arbre_binaire(arbre7) ||
+				element_arbre_binaire(premier_enfant_arbre_binaire(arbre7)) !=
+				3) {
+			printf("Erreur lors du chargement d'un fichier sans en-tête\n");
+		}
+		detruire_arbre_binaire(arbre7);
+		remove("test_v1.bin");
+		arbre_binaire* arbre8 = charger_paresseux_arbre_binaire("test.bin", 1,
+			1);
+		int passe;
+		for (passe = 0; passe < 2; passe = passe + 1) {
+			arbre_binaire* epingle =
+				premier_enfant_epingle_arbre_binaire(arbre8);
+			arbre_binaire* feuille8 =
+				second_enfant_epingle_arbre_binaire(epingle);
+			if (element_arbre_binaire(feuille8) != 7 ||
+					nombre_elements_arbre_binaire(arbre8) != 4) {
+				printf("Erreur lors du chargement paresseux\n");
+			}
+			relacher_arbre_binaire(feuille8);
+			relacher_arbre_binaire(epingle);
+		}
+		detruire_arbre_binaire(arbre8);
+		valeur_arbre_binaire grande_valeur = (valeur_arbre_binaire)1 <<
+			(sizeof(valeur_arbre_binaire) * 8 - 2);
+		arbre_binaire* arbre9 = creer_arbre_binaire(grande_valeur);
+		creer_premier_enfant_arbre_binaire(arbre9, -grande_valeur);
+		size_t capacite = 0;
+		tampon = NULL;
+		taille = serialiser_extensible_arbre_binaire(arbre9, (void**)&tampon,
+			&capacite);
+		arbre_binaire* arbre10 = deserialiser_arbre_binaire(tampon, taille);
+		if (element_arbre_binaire(arbre10) != grande_valeur ||
+				element_arbre_binaire(premier_enfant_arbre_binaire(arbre10)) !=
+				-grande_valeur) {
+			printf("Erreur lors de la sérialisation d'une grande valeur\n");
+		}
+		detruire_arbre_binaire(arbre10);
+		detruire_arbre_binaire(arbre9);
+		free(tampon);
+		arbre_binaire* arbre11 = creer_arbre_binaire(3);
+		creer_premier_enfant_arbre_binaire(arbre11, 1);
+		creer_second_enfant_arbre_binaire(arbre11, 5);
+		transformer_arbre_binaire(arbre11, 2, 1);
+		int64_t somme;
+		valeur_arbre_binaire minimum, maximum;
+		statistiques_arbre_binaire(arbre11, &somme, &minimum, &maximum);
+		if (element_arbre_binaire(arbre11) != 7 || somme != 21 ||
+				minimum != 3 || maximum != 11) {
+			printf("Erreur lors de la transformation des valeurs\n");
+		}
+		valeur_arbre_binaire table[8] = {0, 10, 20, 30, 40, 50, 60, 70};
+		remplacer_valeurs_arbre_binaire(arbre11, table, 8);
+		taille_arbre_binaire compteurs[3];
+		histogramme_arbre_binaire(arbre11, 0, 25, compteurs, 3);
+		if (element_arbre_binaire(arbre11) != 70 || compteurs[0] != 1 ||
+				compteurs[1] != 1 || compteurs[2] != 1) {
+			printf("Erreur lors du remplacement des valeurs\n");
+		}
+		detruire_arbre_binaire(arbre11);
+		arbre_binaire* arbre12 = creer_arbre_binaire(-100);
+		int64_t somme_transformee = 0;
+		int64_t somme_remplacee = 0;
+		taille_arbre_binaire compteurs_attendus[3] = {0, 0, 0};
+		noeud = arbre12;
+		for (valeur = 0; valeur < 3000; valeur = valeur + 1) {
+			valeur_arbre_binaire element = valeur * 37 % 201 - 100;
+			if (valeur > 0) {
+				creer_second_enfant_arbre_binaire(noeud, element);
+				noeud = second_enfant_arbre_binaire(noeud);
+			}
+			element = element * 3 - 7;
+			somme_transformee = somme_transformee + element;
+			if (element < -7) {
+				compteurs_attendus[(element + 307) / 100] =
+					compteurs_attendus[(element + 307) / 100] + 1;
+			}
+			if (element >= 0 && element < 8) {
+				element = table[element];
+			}
+			somme_remplacee = somme_remplacee + element;
+		}
+		transformer_arbre_binaire(arbre12, 3, -7);
+		statistiques_arbre_binaire(arbre12, &somme, &minimum, &maximum);
+		histogramme_arbre_binaire(arbre12, -307, 100, compteurs, 3);
+		if (somme != somme_transformee || minimum != -307 || maximum != 293 ||
+				compteurs[0] != compteurs_attendus[0] ||
+				compteurs[1] != compteurs_attendus[1] ||
+				compteurs[2] != compteurs_attendus[2]) {
+			printf("Erreur lors de la transformation d'un grand arbre\n");
+		}
+		remplacer_valeurs_arbre_binaire(arbre12, table, 8);
+		statistiques_arbre_binaire(arbre12, &somme, NULL, NULL);
+		if (somme != somme_remplacee || a_erreur_arbre_binaire(arbre12)) {
+			printf("Erreur lors du remplacement dans un grand arbre\n");
+		}
+		detruire_arbre_binaire(arbre12);
 		
 		printf("Tests terminés");
 	} else {